@@ -0,0 +1,85 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _ALIGNED_ALLOCATOR_H
+#define _ALIGNED_ALLOCATOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// Alignment of the matrix buffers, a cache line, which is also enough for any vector register
+#define MATRIX_ALIGNMENT 64
+
+// Allocator for vector, handing out blocks aligned to Alignment bytes
+template <class V, size_t Alignment = MATRIX_ALIGNMENT>
+class AlignedAllocator
+{
+	public:
+		typedef V value_type;
+		
+		template <class U>
+		struct rebind
+		{
+			typedef AlignedAllocator<U, Alignment> other;
+		};
+		
+		AlignedAllocator()
+		{
+		}
+		
+		template <class U>
+		AlignedAllocator(const AlignedAllocator<U, Alignment> &)
+		{
+		}
+		
+		V *allocate(size_t n)
+		{
+			void *p = NULL;
+			
+			if(posix_memalign(&p, Alignment, max(n, (size_t) 1) * sizeof(V)) != 0)
+			{
+				throw bad_alloc();
+			}
+			
+			return (V *) p;
+		}
+		
+		void deallocate(V *p, size_t)
+		{
+			free(p);
+		}
+		
+		template <class U>
+		bool operator==(const AlignedAllocator<U, Alignment> &) const
+		{
+			return true;
+		}
+		
+		template <class U>
+		bool operator!=(const AlignedAllocator<U, Alignment> &) const
+		{
+			return false;
+		}
+};
+
+#endif
@@ -0,0 +1,116 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _BIT_MATRIX_H
+#define _BIT_MATRIX_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "aligned_allocator.h"
+
+using namespace std;
+
+// Dense boolean matrix, packed 64 bits to a word, every row starting on a word of its own
+class BitMatrix
+{
+	private:
+		unsigned int num_rows, num_cols, words;	// Words per row
+		vector<uint64_t, AlignedAllocator<uint64_t> > bits;
+		
+	public:
+		BitMatrix(unsigned int num_rows = 0, unsigned int num_cols = 0)
+		{
+			reset(num_rows, num_cols);
+		}
+		
+		// All the bits are cleared
+		void reset(unsigned int num_rows, unsigned int num_cols)
+		{
+			this->num_rows = num_rows;
+			this->num_cols = num_cols;
+			words = wordsFor(num_cols);
+			bits.assign((size_t) num_rows * words, 0);
+		}
+		
+		// Words in a row of num_cols bits, for laying out a matrix in memory of one's own
+		static unsigned int wordsFor(unsigned int num_cols)
+		{
+			return (num_cols + 63) / 64;
+		}
+		
+		bool get(unsigned int row, unsigned int col) const
+		{
+			return (bits[(size_t) row * words + col / 64] >> (col % 64)) & 1;
+		}
+		
+		void set(unsigned int row, unsigned int col)
+		{
+			bits[(size_t) row * words + col / 64] |= (uint64_t) 1 << (col % 64);
+		}
+		
+		uint64_t *row(unsigned int row)
+		{
+			return &bits[(size_t) row * words];
+		}
+		
+		const uint64_t *row(unsigned int row) const
+		{
+			return &bits[(size_t) row * words];
+		}
+		
+		uint64_t *data()
+		{
+			return bits.data();
+		}
+		
+		const uint64_t *data() const
+		{
+			return bits.data();
+		}
+		
+		// Row dest |= row src, a word at a time
+		void orRow(unsigned int dest, unsigned int src)
+		{
+			uint64_t *d = row(dest);
+			const uint64_t *s = row(src);
+			
+			for(unsigned int w = 0; w < words; w++)
+			{
+				d[w] |= s[w];
+			}
+		}
+		
+		unsigned int numRows() const
+		{
+			return num_rows;
+		}
+		
+		unsigned int numCols() const
+		{
+			return num_cols;
+		}
+		
+		unsigned int wordsPerRow() const
+		{
+			return words;
+		}
+};
+
+#endif
@@ -0,0 +1,141 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+// Same vertices, and the same copies of every edge
+template <class T>
+bool sameGraph(const Graph<T> &g1, const Graph<T> &g2)
+{
+	if(g1.getVertices() != g2.getVertices() || g1.numEdges() != g2.numEdges())
+	{
+		return false;
+	}
+	
+	vector<T> labels = g1.getVertices();
+	
+	for(unsigned int i = 0; i < labels.size(); i++)
+	{
+		if(g1.indegree(labels[i]) != g2.indegree(labels[i]) || g1.outdegree(labels[i]) != g2.outdegree(labels[i]))
+		{
+			return false;
+		}
+	}
+	
+	bool same = true;
+	
+	g1.forEachEdge([&](const T &src, const T &dest, int cost)
+	{
+		same = same && (g1.countEdge(src, dest, cost) == g2.countEdge(src, dest, cost));
+	});
+	
+	return same;
+}
+
+int main()
+{
+	vector<Edge<char> > edges;
+	
+	edges.push_back(Edge<char>('a', 'b', 4));
+	edges.push_back(Edge<char>('b', 'c', 2));
+	edges.push_back(Edge<char>('a', 'b', 1));
+	edges.push_back(Edge<char>('c', 'c', 3));
+	edges.push_back(Edge<char>('d', 'a', 5));
+	edges.push_back(Edge<char>('b', 'a', 6));
+	
+	Graph<char> g = Graph<char>::fromEdges(edges, true);
+	
+	cout << "Directed, as given: " << g.numVertices() << " vertices, " << g.numEdges() << " edges" << endl;
+	
+	Graph<char> simplified = Graph<char>::fromEdges(edges, true, true, true);
+	
+	cout << "Directed, simplified: " << simplified.numEdges() << " edges, a -> b costs";
+	vector<int> costs = simplified.edgeCosts('a', 'b');
+	for(unsigned int i = 0; i < costs.size(); i++)
+	{
+		cout << " " << costs[i];
+	}
+	cout << endl;
+	
+	Graph<char> undirected = Graph<char>::fromEdges(edges, false, true);
+	
+	cout << "Undirected, deduplicated: " << undirected.numEdges() << " edges, a - b costs";
+	costs = undirected.edgeCosts('b', 'a');
+	for(unsigned int i = 0; i < costs.size(); i++)
+	{
+		cout << " " << costs[i];
+	}
+	cout << ", degree of c " << undirected.outdegree('c') << endl;
+	
+	// Random multigraphs, against one addEdge() at a time
+	for(int directed = 0; directed <= 1; directed++)
+	{
+		vector<Edge<int> > random;
+		Graph<int> one_by_one(directed);
+		const int n = 300;
+		
+		srand(23 + directed);
+		
+		for(int i = 0; i < 6 * n; i++)
+		{
+			random.push_back(Edge<int>(rand() % n, rand() % n, rand() % 5));
+			
+			one_by_one.addVertex(random.back().src);
+			one_by_one.addVertex(random.back().dest);
+			one_by_one.addEdge(random.back().src, random.back().dest, random.back().cost);
+		}
+		
+		Graph<int> built = Graph<int>::fromEdges(random, directed);
+		
+		cout << (directed? "Directed": "Undirected") << " random multigraph: " << (sameGraph(built, one_by_one)? "same": "different");
+		
+		Graph<int> simplified = Graph<int>::fromEdges(random, directed, true, true);
+		
+		one_by_one.simplify();
+		
+		cout << ", simplified " << (sameGraph(simplified, one_by_one)? "same": "different") << endl;
+		
+		// Every edge of the bulk built graph can be removed again, which needs the reverse adjacency to be right
+		vector<Edge<int> > all;
+		
+		built.exportEdges(all);
+		
+		for(unsigned int i = 0; i < all.size(); i++)
+		{
+			built.removeEdge(all[i].src, all[i].dest, all[i].cost);
+		}
+		
+		vector<int> labels = built.getVertices();
+		unsigned int left = 0;
+		
+		for(unsigned int i = 0; i < labels.size(); i++)
+		{
+			left += built.indegree(labels[i]);
+		}
+		
+		cout << "Incoming edges left after removing all: " << left << endl;
+	}
+	
+	return 0;
+}
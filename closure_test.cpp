@@ -0,0 +1,149 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+int main()
+{
+	Graph<char> g(true);
+	
+	for(char c = 'a'; c <= 'f'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	// b, c and d form a cycle
+	g.addEdge('a', 'b');
+	g.addEdge('b', 'c');
+	g.addEdge('c', 'd');
+	g.addEdge('d', 'b');
+	g.addEdge('d', 'e');
+	g.addEdge('f', 'e');
+	
+	pair<vector<char>, BitMatrix> closure = g.transitiveClosure();
+	
+	cout << "  ";
+	for(unsigned int j = 0; j < closure.first.size(); j++)
+	{
+		cout << closure.first[j] << " ";
+	}
+	cout << endl;
+	
+	for(unsigned int i = 0; i < closure.first.size(); i++)
+	{
+		cout << closure.first[i] << " ";
+		
+		for(unsigned int j = 0; j < closure.first.size(); j++)
+		{
+			cout << closure.second.get(i, j) << " ";
+		}
+		
+		cout << endl;
+	}
+	
+	cout << "Strongly connected: " << g.isConnected() << endl;
+	
+	g.addEdge('e', 'a');
+	g.addEdge('e', 'f');
+	
+	cout << "Strongly connected after adding e -> a and e -> f: " << g.isConnected() << endl;
+	
+	// Random graphs, wider than one word, must agree with the plain search in both the modes
+	Graph<int> r(true);
+	const int n = 300;
+	unsigned int mismatches = 0, positives = 0;
+	
+	srand(5);
+	
+	for(int i = 0; i < n; i++)
+	{
+		r.addVertex(i);
+	}
+	
+	for(int i = 0; i < 2 * n; i++)
+	{
+		int u = rand() % n, v = rand() % n;
+		
+		// Mostly forward edges, so that there are some long chains along with a few cycles
+		if(rand() % 8 != 0 && u > v)
+		{
+			swap(u, v);
+		}
+		
+		r.addEdge(u, v);
+	}
+	
+	pair<vector<int>, BitMatrix> serial = r.transitiveClosure(false);
+	pair<vector<int>, BitMatrix> parallel = r.transitiveClosure(true);
+	
+	for(int i = 0; i < n; i++)
+	{
+		for(int j = 0; j < n; j++)
+		{
+			bool expected = (i == j) || r.pathExists(serial.first[i], serial.first[j]);
+			
+			positives += expected;
+			
+			if(serial.second.get(i, j) != expected || parallel.second.get(i, j) != expected)
+			{
+				mismatches++;
+			}
+		}
+	}
+	
+	cout << "Random pairs: " << positives << " reachable, " << mismatches << " mismatch(es)" << endl;
+	
+	// Wide enough levels for the parallel mode to split them, the serial mode must build the very same closure
+	Graph<int> w(true);
+	const int m = 3000;
+	unsigned int differences = 0;
+	
+	for(int i = 0; i < m; i++)
+	{
+		w.addVertex(i);
+	}
+	
+	for(int i = 0; i < 2 * m; i++)
+	{
+		int u = rand() % m, v = rand() % m;
+		
+		w.addEdge(max(u, v), min(u, v));
+	}
+	
+	serial = w.transitiveClosure(false);
+	parallel = w.transitiveClosure(true);
+	differences += (serial.first != parallel.first);
+	
+	for(int i = 0; i < m; i++)
+	{
+		for(int j = 0; j < m; j++)
+		{
+			differences += (serial.second.get(i, j) != parallel.second.get(i, j));
+		}
+	}
+	
+	cout << "Serial and parallel closures of " << m << " vertices, differences: " << differences << endl;
+	
+	return 0;
+}
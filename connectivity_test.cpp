@@ -0,0 +1,144 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+int main()
+{
+	Graph<int> g(false);
+	
+	g.enableConnectivityIndex();
+	
+	for(int i = 1; i <= 8; i++)
+	{
+		g.addVertex(i);
+	}
+	
+	g.addEdge(1, 2);
+	g.addEdge(2, 3);
+	g.addEdge(4, 5);
+	g.addEdge(6, 7);
+	g.addEdge(7, 6);
+	
+	cout << "Components: " << g.numComponents() << endl;
+	cout << "1 ~ 3: " << g.connected(1, 3) << endl;
+	cout << "1 ~ 4: " << g.connected(1, 4) << endl;
+	cout << "Component of 7: " << g.componentOf(7) << endl;
+	
+	g.addEdge(3, 4);
+	
+	cout << "Components after adding 3 - 4: " << g.numComponents() << endl;
+	cout << "1 ~ 5: " << g.connected(1, 5) << endl;
+	
+	g.removeEdge(2, 3);
+	
+	cout << "Components after removing 2 - 3: " << g.numComponents() << endl;
+	cout << "1 ~ 5: " << g.connected(1, 5) << endl;
+	
+	g.removeVertex(8);
+	g.addVertex(9);
+	g.addEdge(9, 1);
+	
+	vector<vector<int> > comp = g.getVerticesComponentwise();
+	
+	for(int i = 0; i < comp.size(); i++)
+	{
+		cout << "{ ";
+		
+		for(int j = 0; j < comp[i].size(); j++)
+		{
+			cout << comp[i][j] << " ";
+		}
+		
+		cout << "} ";
+	}
+	
+	cout << endl;
+	
+	// Interleaved updates and queries must agree with a graph without the index
+	Graph<int> indexed(false), plain(false);
+	const int n = 300;
+	unsigned int mismatches = 0;
+	
+	indexed.enableConnectivityIndex();
+	srand(3);
+	
+	for(int i = 0; i < n; i++)
+	{
+		indexed.addVertex(i);
+		plain.addVertex(i);
+	}
+	
+	for(int i = 0; i < 2 * n; i++)
+	{
+		indexed.addEdge(rand() % n, rand() % n);
+	}
+	
+	plain = indexed;
+	
+	for(int i = 0; i < 4 * n; i++)
+	{
+		int u = rand() % n, v = rand() % n;
+		int op = rand() % 10;
+		
+		if(op < 4)
+		{
+			// Removes one of the existing edges, which is most likely a tree edge
+			vector<Edge<int> *> edges = plain.getEdges();
+			Edge<int> *e = edges[rand() % edges.size()];
+			
+			indexed.removeEdge(e->src, e->dest);
+			plain.removeEdge(e->src, e->dest);
+			
+			for(int j = 0; j < edges.size(); j++)
+			{
+				delete edges[j];
+			}
+		}
+		else if(op == 4)
+		{
+			indexed.removeVertex(u);
+			plain.removeVertex(u);
+			indexed.addVertex(u);
+			plain.addVertex(u);
+		}
+		else
+		{
+			indexed.addEdge(u, v);
+			plain.addEdge(u, v);
+		}
+		
+		int a = rand() % n, b = rand() % n;
+		
+		if(indexed.connected(a, b) != plain.pathExists(a, b) || indexed.numComponents() != plain.getVerticesComponentwise().size())
+		{
+			mismatches++;
+		}
+	}
+	
+	cout << "Streaming: " << indexed.numComponents() << " component(s), " << mismatches << " mismatch(es)" << endl;
+	
+	return 0;
+}
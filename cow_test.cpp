@@ -0,0 +1,251 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "graph.h"
+
+using namespace std;
+
+// Every copy of every edge, in a fixed order
+vector<tuple<int, int, int> > edgeList(const Graph<int> &g)
+{
+	vector<Edge<int> > edges;
+	vector<tuple<int, int, int> > res;
+	
+	g.exportEdges(edges);
+	
+	for(unsigned int i = 0; i < edges.size(); i++)
+	{
+		res.push_back(make_tuple(edges[i].src, edges[i].dest, edges[i].cost));
+	}
+	
+	sort(res.begin(), res.end());
+	
+	return res;
+}
+
+bool sameGraph(const Graph<int> &g1, const Graph<int> &g2)
+{
+	return g1.getVertices() == g2.getVertices() && edgeList(g1) == edgeList(g2);
+}
+
+// The same modification on both the graphs, picked by op out of 10
+void apply(Graph<int> &g1, Graph<int> &g2, int u, int v, int cost, int op, int &next_label)
+{
+	if(op < 5)
+	{
+		g1.addEdge(u, v, cost);
+		g2.addEdge(u, v, cost);
+	}
+	else if(op < 7)
+	{
+		g1.removeEdge(u, v, cost);
+		g2.removeEdge(u, v, cost);
+	}
+	else if(op == 7)
+	{
+		g1.removeVertex(u);
+		g2.removeVertex(u);
+		g1.addVertex(u);
+		g2.addVertex(u);
+	}
+	else if(op == 8)
+	{
+		// Merged under a new label, the label given up is added back
+		g1.mergeVertices(u, v, next_label);
+		g2.mergeVertices(u, v, next_label);
+		
+		if(u != v)
+		{
+			g1.renameVertex(next_label, u);
+			g2.renameVertex(next_label, u);
+			g1.addVertex(v);
+			g2.addVertex(v);
+		}
+	}
+	else
+	{
+		g1.simplify();
+		g2.simplify();
+	}
+}
+
+// The same random modification on both the graphs
+void modify(Graph<int> &g1, Graph<int> &g2, int n, int &next_label)
+{
+	int u = rand() % n, v = rand() % n, cost = rand() % 5, op = rand() % 10;
+	
+	apply(g1, g2, u, v, cost, op, next_label);
+}
+
+int main()
+{
+	Graph<char> g(true);
+	
+	for(char c = 'A'; c <= 'F'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('A', 'B', 2);
+	g.addEdge('B', 'C', 3);
+	g.addEdge('C', 'D', 1);
+	g.addEdge('D', 'E', 4);
+	g.addEdge('E', 'F', 5);
+	g.addEdge('F', 'A', 6);
+	g.enableCopyOnWrite();
+	
+	Graph<char> snapshot(g);
+	
+	cout << "Vertices sharing their edges: " << snapshot.numSharedVertices() << " of " << snapshot.numVertices() << endl;
+	
+	g.addEdge('A', 'C', 7);
+	cout << "After adding A -> C: " << snapshot.numSharedVertices() << endl;
+	
+	g.removeEdge('D', 'E', 4);
+	cout << "After removing D -> E: " << snapshot.numSharedVertices() << endl;
+	
+	cout << "Modified:" << endl << g << endl;
+	cout << "Snapshot:" << endl << snapshot << endl;
+	
+	g.disableCopyOnWrite();
+	
+	Graph<char> deep(g);
+	
+	cout << "Vertices sharing their edges after a deep copy: " << deep.numSharedVertices() << endl << endl;
+	
+	// The forks and the original must behave exactly like independent copies
+	for(int directed = 0; directed < 2; directed++)
+	{
+		const int n = 300;
+		Graph<int> original(directed), reference(directed);
+		
+		srand(11 + directed);
+		
+		for(int i = 0; i < n; i++)
+		{
+			original.addVertex(i);
+			reference.addVertex(i);
+		}
+		
+		for(int i = 0; i < 3 * n; i++)
+		{
+			int u = rand() % n, v = rand() % n, cost = rand() % 5;
+			
+			original.addEdge(u, v, cost);
+			reference.addEdge(u, v, cost);
+		}
+		
+		original.enableCopyOnWrite();
+		
+		Graph<int> fork(original), fork_reference(reference);
+		Graph<int> second(fork), second_reference(reference);
+		unsigned int mismatches = 0;
+		int next_label = n;
+		
+		for(int round = 0; round < 400; round++)
+		{
+			modify(fork, fork_reference, n, next_label);
+			
+			if(round % 2 == 0)
+			{
+				modify(second, second_reference, n, next_label);
+			}
+			
+			if(round % 4 == 0)
+			{
+				modify(original, reference, n, next_label);
+			}
+			
+			if(round < 20)
+			{
+				mismatches += !sameGraph(fork, fork_reference) + !sameGraph(second, second_reference) + !sameGraph(original, reference);
+			}
+		}
+		
+		mismatches += !sameGraph(fork, fork_reference) + !sameGraph(second, second_reference) + !sameGraph(original, reference);
+		mismatches += (fork.isAcyclic() != fork_reference.isAcyclic()) + (second.isConnected() != second_reference.isConnected());
+		
+		cout << (directed? "Directed": "Undirected") << " forks, mismatches against independent copies: " << mismatches << endl;
+		cout << "Vertices still sharing their edges: " << original.numSharedVertices() << " of " << original.numVertices() << endl;
+	}
+	
+	// Sibling forks modified on threads of their own, after the graph they were forked from is gone
+	{
+		const int n = 300, num_threads = 4;
+		Graph<int> original(true), reference(true);
+		
+		srand(17);
+		
+		for(int i = 0; i < n; i++)
+		{
+			original.addVertex(i);
+			reference.addVertex(i);
+		}
+		
+		for(int i = 0; i < 3 * n; i++)
+		{
+			int u = rand() % n, v = rand() % n, cost = rand() % 5;
+			
+			original.addEdge(u, v, cost);
+			reference.addEdge(u, v, cost);
+		}
+		
+		original.enableCopyOnWrite();
+		
+		vector<Graph<int> > forks(num_threads, original), references(num_threads, reference);
+		vector<thread> pool;
+		unsigned int mismatches = 0;
+		
+		original = Graph<int>(true);
+		
+		for(int t = 0; t < num_threads; t++)
+		{
+			pool.push_back(thread([&forks, &references, t]()
+			{
+				Xoshiro256 rng(t + 1);
+				int next_label = n;
+				
+				for(int round = 0; round < 2000; round++)
+				{
+					int u = rng.below(n), v = rng.below(n), cost = rng.below(5), op = rng.below(10);
+					
+					apply(forks[t], references[t], u, v, cost, op, next_label);
+				}
+			}));
+		}
+		
+		for(int t = 0; t < num_threads; t++)
+		{
+			pool[t].join();
+			mismatches += !sameGraph(forks[t], references[t]);
+		}
+		
+		cout << "Forks modified concurrently, mismatches against independent copies: " << mismatches << endl;
+	}
+	
+	return 0;
+}
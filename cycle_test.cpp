@@ -0,0 +1,98 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include "graph.h"
+#include <iostream>
+
+using namespace std;
+
+template <class T>
+void printCycle(const Graph<T> &g)
+{
+	vector<T> cycle;
+	
+	if(g.isAcyclic(cycle))
+	{
+		cout << "Acyclic" << endl;
+		return;
+	}
+	
+	cout << "Cycle: ";
+	
+	for(unsigned int i = 0; i < cycle.size(); i++)
+	{
+		cout << cycle[i] << " ";
+	}
+	
+	cout << endl;
+}
+
+int main()
+{
+	Graph<int> g(false);
+	
+	for(int i = 1; i <= 7; i++)
+	{
+		g.addVertex(i);
+	}
+	
+	// A tree
+	g.addEdge(1, 2);
+	g.addEdge(1, 3);
+	g.addEdge(2, 4);
+	g.addEdge(2, 5);
+	g.addEdge(6, 7);
+	
+	printCycle(g);
+	
+	g.addEdge(5, 3);
+	printCycle(g);
+	
+	g.removeEdge(5, 3);
+	g.addEdge(7, 6);
+	printCycle(g);
+	
+	g.removeEdge(7, 6);
+	g.addEdge(4, 4);
+	printCycle(g);
+	cout << "Acyclic: " << g.isAcyclic() << endl;
+	
+	// Directed graphs
+	Graph<char> d(true);
+	
+	for(char c = 'a'; c <= 'f'; c++)
+	{
+		d.addVertex(c);
+	}
+	
+	d.addEdge('a', 'b');
+	d.addEdge('a', 'c');
+	d.addEdge('b', 'd');
+	d.addEdge('c', 'd');
+	d.addEdge('d', 'e');
+	d.addEdge('e', 'f');
+	
+	printCycle(d);
+	
+	d.addEdge('f', 'c');
+	printCycle(d);
+	cout << "Acyclic: " << d.isAcyclic() << endl;
+	
+	return 0;
+}
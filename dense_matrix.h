@@ -0,0 +1,82 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _DENSE_MATRIX_H
+#define _DENSE_MATRIX_H
+
+#include <vector>
+
+#include "aligned_allocator.h"
+
+using namespace std;
+
+// Dense matrix in one contiguous, row major and aligned buffer, element (r, c) is at data()[r * numCols() + c]
+template <class V>
+class DenseMatrix
+{
+	private:
+		unsigned int num_rows, num_cols;
+		vector<V, AlignedAllocator<V> > elems;
+		
+	public:
+		DenseMatrix(unsigned int num_rows = 0, unsigned int num_cols = 0, V value = V())
+		{
+			reset(num_rows, num_cols, value);
+		}
+		
+		// Every element is set to value
+		void reset(unsigned int num_rows, unsigned int num_cols, V value = V())
+		{
+			this->num_rows = num_rows;
+			this->num_cols = num_cols;
+			elems.assign((size_t) num_rows * num_cols, value);
+		}
+		
+		V & operator()(unsigned int row, unsigned int col)
+		{
+			return elems[(size_t) row * num_cols + col];
+		}
+		
+		const V & operator()(unsigned int row, unsigned int col) const
+		{
+			return elems[(size_t) row * num_cols + col];
+		}
+		
+		V *data()
+		{
+			return elems.data();
+		}
+		
+		const V *data() const
+		{
+			return elems.data();
+		}
+		
+		unsigned int numRows() const
+		{
+			return num_rows;
+		}
+		
+		unsigned int numCols() const
+		{
+			return num_cols;
+		}
+};
+
+#endif
@@ -20,102 +20,292 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #ifndef _DISJOINT_SET
 #define _DISJOINT_SET
 
+#include <atomic>
 #include <iostream>
 #include <map>
+#include <vector>
 
 using namespace std;
 
-template<class T>
-class DisjointSet  // Weighted quick union + Path compression
+class DenseDisjointSet  // Union by rank + Path halving over the elements 0 .. n-1
 {
 	private:
-		map<T, unsigned int> size;
-		map<T, T> parent;
-	
-		void combine(T set1, T set2)
+		vector<unsigned int> parent;
+		vector<unsigned int> size;
+		vector<unsigned char> rank;
+		unsigned int num_sets;
+
+	public:
+		DenseDisjointSet(unsigned int n = 0)
+		{
+			reset(n);
+		}
+
+		void reset(unsigned int n)
+		{
+			parent.resize(n);
+			size.assign(n, 1);
+			rank.assign(n, 0);
+			num_sets = n;
+
+			for(unsigned int i = 0; i < n; i++)
+			{
+				parent[i] = i;
+			}
+		}
+
+		// Adds a new singleton set and returns its element
+		unsigned int add()
+		{
+			parent.push_back(parent.size());
+			size.push_back(1);
+			rank.push_back(0);
+			num_sets++;
+
+			return parent.size() - 1;
+		}
+
+		unsigned int find(unsigned int elem)
+		{
+			while(parent[elem] != elem)
+			{
+				parent[elem] = parent[parent[elem]];
+				elem = parent[elem];
+			}
+
+			return elem;
+		}
+
+		// Returns false if both the elements were already in the same set
+		bool join(unsigned int elem1, unsigned int elem2)
+		{
+			unsigned int elem1_set = find(elem1);
+			unsigned int elem2_set = find(elem2);
+
+			if(elem1_set == elem2_set)
+			{
+				return false;
+			}
+
+			if(rank[elem1_set] < rank[elem2_set])
+			{
+				swap(elem1_set, elem2_set);
+			}
+			else if(rank[elem1_set] == rank[elem2_set])
+			{
+				rank[elem1_set]++;
+			}
+
+			parent[elem2_set] = elem1_set;
+			size[elem1_set] += size[elem2_set];
+			num_sets--;
+
+			return true;
+		}
+
+		bool connected(unsigned int elem1, unsigned int elem2)
+		{
+			return find(elem1) == find(elem2);
+		}
+
+		unsigned int parentOf(unsigned int elem) const
+		{
+			return parent[elem];
+		}
+
+		// Size of the set whose root is given
+		unsigned int setSize(unsigned int root) const
 		{
-			parent[set1] = set2;
-			size[set2] += size[set1];
+			return size[root];
+		}
+
+		unsigned int numElements() const
+		{
+			return parent.size();
+		}
+
+		unsigned int numSets() const
+		{
+			return num_sets;
+		}
+};
+
+class ConcurrentDisjointSet  // Lock free union find over the elements 0 .. n-1 (Jayanti-Tarjan style randomized linking)
+{
+	private:
+		vector<atomic<unsigned int> > parent;
+
+		// Fixed pseudo random total order on the elements, roots are always linked below a larger one
+		static bool precedes(unsigned int elem1, unsigned int elem2)
+		{
+			unsigned int h1 = elem1 * 2654435761u, h2 = elem2 * 2654435761u;
+
+			return (h1 < h2) || ((h1 == h2) && (elem1 < elem2));
 		}
 
 	public:
-		bool exists(T elem)
+		ConcurrentDisjointSet(unsigned int n) : parent(n)
 		{
-			return parent.find(elem) != parent.end();
+			for(unsigned int i = 0; i < n; i++)
+			{
+				parent[i].store(i, memory_order_relaxed);
+			}
 		}
-		
-		void create(T elem)
+
+		unsigned int find(unsigned int elem)
 		{
-			if(!exists(elem))
+			while(true)
 			{
-				parent[elem] = elem;
-				size[elem] = 1;
+				unsigned int par = parent[elem].load(memory_order_acquire);
+
+				if(par == elem)
+				{
+					return elem;
+				}
+
+				unsigned int grand_par = parent[par].load(memory_order_acquire);
+
+				// Path halving, losing the race to another thread is harmless
+				if(par != grand_par)
+				{
+					parent[elem].compare_exchange_weak(par, grand_par, memory_order_release, memory_order_relaxed);
+				}
+
+				elem = grand_par;
 			}
 		}
 
-		void join(T elem1, T elem2)
+		// Returns false if both the elements were already in the same set
+		bool join(unsigned int elem1, unsigned int elem2)
 		{
-			T elem1_set = find(elem1);
-			T elem2_set = find(elem2);
-			
-			if(elem1_set != elem2_set)
+			while(true)
 			{
-				if(size[elem1_set] < size[elem2_set])
+				elem1 = find(elem1);
+				elem2 = find(elem2);
+
+				if(elem1 == elem2)
+				{
+					return false;
+				}
+
+				if(precedes(elem2, elem1))
 				{
-					combine(elem1_set, elem2_set);
+					swap(elem1, elem2);
 				}
-				else
+
+				// Succeeds only if elem1 is still a root, otherwise retry from the new roots
+				unsigned int expected = elem1;
+
+				if(parent[elem1].compare_exchange_strong(expected, elem2, memory_order_acq_rel))
 				{
-					combine(elem2_set, elem1_set);
+					return true;
 				}
 			}
+		}
+
+		bool connected(unsigned int elem1, unsigned int elem2)
+		{
+			while(true)
+			{
+				elem1 = find(elem1);
+				elem2 = find(elem2);
+
+				if(elem1 == elem2)
+				{
+					return true;
+				}
+
+				// elem1 was not linked meanwhile, so the answer was valid at this point
+				if(parent[elem1].load(memory_order_acquire) == elem1)
+				{
+					return false;
+				}
+			}
+		}
+
+		unsigned int numElements() const
+		{
+			return parent.size();
+		}
+};
+
+template<class T>
+class DisjointSet  // Maps the elements to dense ids and keeps the sets in a DenseDisjointSet
+{
+	private:
+		map<T, unsigned int> id;
+		vector<T> elems;
+		DenseDisjointSet sets;
+
+		// Elements which were never created are added as singleton sets
+		unsigned int idOf(const T &elem)
+		{
+			typename map<T, unsigned int>::iterator itr = id.find(elem);
+
+			if(itr != id.end())
+			{
+				return itr->second;
+			}
+
+			unsigned int new_id = sets.add();
+
+			id[elem] = new_id;
+			elems.push_back(elem);
+
+			return new_id;
+		}
+
+	public:
+		bool exists(T elem) const
+		{
+			return id.find(elem) != id.end();
+		}
+		
+		void create(T elem)
+		{
+			idOf(elem);
+		}
+
+		void join(T elem1, T elem2)
+		{
+			sets.join(idOf(elem1), idOf(elem2));
 		}		
 	
 		bool connected(T elem1, T elem2)
 		{
-			return find(elem1) == find(elem2);
+			return sets.connected(idOf(elem1), idOf(elem2));
 		}
 	
-		T find(int elem)
+		T find(T elem)
 		{
-			return (parent[elem] = (parent[elem] == elem? elem: find(parent[elem])));
+			return elems[sets.find(idOf(elem))];
 		}
 
-		map<T, unsigned int> getSetsWithSize()
+		map<T, unsigned int> getSetsWithSize() const
 		{
 			map<T, unsigned int> res;
 
-			for(typename map<T, unsigned int>::iterator itr = size.begin(); itr != size.end(); itr++)
+			for(unsigned int i = 0; i < elems.size(); i++)
 			{
-				if(parent[itr->first] == itr->first)	// Root of the set
+				if(sets.parentOf(i) == i)	// Root of the set
 				{
-					res[itr->first] = itr->second;
+					res[elems[i]] = sets.setSize(i);
 				}
 			}
 
 			return res;
 		}
 
-		unsigned int numSets()
+		unsigned int numSets() const
 		{
-			unsigned int cnt = 0;
-
-			for(typename map<T, unsigned int>::iterator itr = size.begin(); itr != size.end(); itr++)
-			{
-				if(parent[itr->first] == itr->first)	// Root of the set
-				{
-					cnt++;
-				}
-			}
-
-			return cnt;
+			return sets.numSets();
 		}
 
 		friend ostream& operator<<(ostream &out, DisjointSet<T> &s)
 		{
-			for(typename map<T, T>::iterator itr = s.parent.begin(); itr != s.parent.end(); itr++)
+			for(typename map<T, unsigned int>::iterator itr = s.id.begin(); itr != s.id.end(); itr++)
 			{
-				out << itr->first << " ------> " << itr->second << endl;
+				out << itr->first << " ------> " << s.elems[s.sets.parentOf(itr->second)] << endl;
 			}
             
             out << "Sets: " << endl;
@@ -0,0 +1,107 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "disjoint_set.h"
+
+using namespace std;
+
+int main()
+{
+	DisjointSet<string> s;
+	
+	s.create("red");
+	s.create("green");
+	s.create("blue");
+	s.create("cyan");
+	s.create("magenta");
+	
+	cout << "Sets: " << s.numSets() << endl;
+	
+	s.join("green", "blue");
+	s.join("cyan", "green");
+	s.join("cyan", "blue");
+	
+	cout << "Sets: " << s.numSets() << endl;
+	cout << "cyan ~ blue: " << s.connected("cyan", "blue") << endl;
+	cout << "red ~ blue: " << s.connected("red", "blue") << endl;
+	cout << s << endl;
+	
+	// A long chain must not exhaust the stack
+	const unsigned int n = 1000000;
+	DenseDisjointSet d(n);
+	
+	for(unsigned int i = 1; i < n; i++)
+	{
+		d.join(i - 1, i);
+	}
+	
+	cout << "Chain: " << d.numSets() << " set(s), 0 ~ " << n - 1 << ": " << d.connected(0, n - 1) << endl;
+	
+	// Concurrent joins must end up with the same partition as sequential ones
+	const unsigned int m = 100000, num_threads = 4;
+	vector<pair<unsigned int, unsigned int> > pairs;
+	DenseDisjointSet seq(m);
+	ConcurrentDisjointSet con(m);
+	
+	srand(11);
+	
+	for(unsigned int i = 0; i < m; i++)
+	{
+		pairs.push_back(make_pair(rand() % m, rand() % m));
+		seq.join(pairs[i].first, pairs[i].second);
+	}
+	
+	vector<thread> pool;
+	
+	for(unsigned int t = 0; t < num_threads; t++)
+	{
+		pool.push_back(thread([&, t]()
+		{
+			for(unsigned int i = t; i < m; i += num_threads)
+			{
+				con.join(pairs[i].first, pairs[i].second);
+			}
+		}));
+	}
+	
+	for(unsigned int t = 0; t < num_threads; t++)
+	{
+		pool[t].join();
+	}
+	
+	unsigned int mismatches = 0;
+	
+	for(unsigned int i = 1; i < m; i++)
+	{
+		if(seq.connected(0, i) != con.connected(0, i) || seq.connected(i - 1, i) != con.connected(i - 1, i))
+		{
+			mismatches++;
+		}
+	}
+	
+	cout << "Concurrent joins: " << seq.numSets() << " set(s), " << mismatches << " mismatch(es)" << endl;
+	
+	return 0;
+}
@@ -0,0 +1,388 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _DYNAMIC_CONNECTIVITY_H
+#define _DYNAMIC_CONNECTIVITY_H
+
+#include <cassert>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "stamped_marks.h"
+
+using namespace std;
+
+/**
+	Connectivity of an undirected multigraph over the vertices 0 .. n-1, under insertion and deletion of edges.
+
+	A spanning forest is kept along with a component id per vertex, so queries are O(1).
+	Merging two trees relabels the smaller one. Deleting a tree edge explores both the halves
+	alternately, stops as soon as the smaller one is exhausted, and looks for a replacement among
+	the non tree edges of the smaller half only. If there is none, the smaller half is relabelled.
+**/
+class DynamicConnectivity
+{
+	private:
+		vector<set<unsigned int> > tree_adj;
+		vector<map<unsigned int, unsigned int> > non_tree_adj; // Neighbour -> multiplicity
+
+		vector<unsigned int> component;
+		vector<unsigned int> component_size;	// Indexed by the component id
+		vector<unsigned int> component_root;	// Some vertex of the component, indexed by the component id
+		vector<unsigned int> free_ids;
+		unsigned int num_components;
+
+		StampedMarks seen;	// Marks of the tree searches
+
+		unsigned int newComponent(unsigned int root, unsigned int size)
+		{
+			unsigned int id;
+
+			if(free_ids.empty())
+			{
+				id = component_size.size();
+				component_size.push_back(size);
+				component_root.push_back(root);
+			}
+			else
+			{
+				id = free_ids.back();
+				free_ids.pop_back();
+				component_size[id] = size;
+				component_root[id] = root;
+			}
+
+			num_components++;
+
+			return id;
+		}
+
+		void freeComponent(unsigned int id)
+		{
+			free_ids.push_back(id);
+			num_components--;
+		}
+
+		// Collects the tree of vertex into res and relabels it, if label is not -1
+		void collectTree(unsigned int vertex, vector<unsigned int> &res, int label)
+		{
+			unsigned int st = seen.next();
+
+			res.clear();
+			res.push_back(vertex);
+			seen.mark(vertex, st);
+
+			for(unsigned int i = 0; i < res.size(); i++)
+			{
+				if(label != -1)
+				{
+					component[res[i]] = label;
+				}
+
+				for(set<unsigned int>::const_iterator w = tree_adj[res[i]].begin(); w != tree_adj[res[i]].end(); w++)
+				{
+					if(!seen.marked(*w, st))
+					{
+						seen.mark(*w, st);
+						res.push_back(*w);
+					}
+				}
+			}
+		}
+
+		void addNonTreeEdge(unsigned int u, unsigned int v, unsigned int count)
+		{
+			non_tree_adj[u][v] += count;
+			non_tree_adj[v][u] += count;
+		}
+
+		// Returns false if there is no such non tree edge
+		bool removeNonTreeEdge(unsigned int u, unsigned int v)
+		{
+			map<unsigned int, unsigned int>::iterator uv = non_tree_adj[u].find(v);
+
+			if(uv == non_tree_adj[u].end())
+			{
+				return false;
+			}
+
+			map<unsigned int, unsigned int>::iterator vu = non_tree_adj[v].find(u);
+
+			if(--(uv->second) == 0)
+			{
+				non_tree_adj[u].erase(uv);
+			}
+
+			if(--(vu->second) == 0)
+			{
+				non_tree_adj[v].erase(vu);
+			}
+
+			return true;
+		}
+
+		void cutTreeEdge(unsigned int u, unsigned int v)
+		{
+			tree_adj[u].erase(v);
+			tree_adj[v].erase(u);
+
+			// Both the halves are explored in lock step, until one of them runs out of vertices
+			unsigned int st_u = seen.next();
+			unsigned int st_v = seen.next();
+			vector<unsigned int> side_u(1, u), side_v(1, v);
+			unsigned int pos_u = 0, pos_v = 0;
+
+			seen.mark(u, st_u);
+			seen.mark(v, st_v);
+
+			while(pos_u < side_u.size() && pos_v < side_v.size())
+			{
+				unsigned int x = side_u[pos_u++];
+
+				for(set<unsigned int>::const_iterator w = tree_adj[x].begin(); w != tree_adj[x].end(); w++)
+				{
+					if(!seen.marked(*w, st_u))
+					{
+						seen.mark(*w, st_u);
+						side_u.push_back(*w);
+					}
+				}
+
+				x = side_v[pos_v++];
+
+				for(set<unsigned int>::const_iterator w = tree_adj[x].begin(); w != tree_adj[x].end(); w++)
+				{
+					if(!seen.marked(*w, st_v))
+					{
+						seen.mark(*w, st_v);
+						side_v.push_back(*w);
+					}
+				}
+			}
+
+			bool u_smaller = (pos_u == side_u.size());
+			vector<unsigned int> &small = u_smaller? side_u: side_v;
+			unsigned int st_small = u_smaller? st_u: st_v;
+			unsigned int other = u_smaller? v: u;
+
+			// Any non tree edge leaving the smaller half reconnects the tree
+			for(unsigned int i = 0; i < small.size(); i++)
+			{
+				unsigned int x = small[i];
+
+				for(map<unsigned int, unsigned int>::const_iterator w = non_tree_adj[x].begin(); w != non_tree_adj[x].end(); w++)
+				{
+					if(!seen.marked(w->first, st_small))
+					{
+						unsigned int y = w->first;
+
+						removeNonTreeEdge(x, y);
+						tree_adj[x].insert(y);
+						tree_adj[y].insert(x);
+
+						return;
+					}
+				}
+			}
+
+			// No replacement, the smaller half becomes a component of its own
+			unsigned int old_id = component[u];
+			unsigned int new_id = newComponent(small[0], small.size());
+
+			for(unsigned int i = 0; i < small.size(); i++)
+			{
+				component[small[i]] = new_id;
+			}
+
+			component_size[old_id] -= small.size();
+
+			if(component[component_root[old_id]] != old_id)
+			{
+				component_root[old_id] = other;
+			}
+		}
+
+		// Renames vertex from to to in the adjacency of its neighbours
+		void renumber(unsigned int from, unsigned int to)
+		{
+			for(set<unsigned int>::const_iterator w = tree_adj[from].begin(); w != tree_adj[from].end(); w++)
+			{
+				tree_adj[*w].erase(from);
+				tree_adj[*w].insert(to);
+			}
+
+			for(map<unsigned int, unsigned int>::const_iterator w = non_tree_adj[from].begin(); w != non_tree_adj[from].end(); w++)
+			{
+				non_tree_adj[w->first].erase(from);
+				non_tree_adj[w->first][to] = w->second;
+			}
+
+			tree_adj[to].swap(tree_adj[from]);
+			non_tree_adj[to].swap(non_tree_adj[from]);
+			component[to] = component[from];
+			seen.move(from, to);
+
+			if(component_root[component[to]] == from)
+			{
+				component_root[component[to]] = to;
+			}
+		}
+
+	public:
+		DynamicConnectivity(unsigned int n = 0)
+		{
+			reset(n);
+		}
+
+		void reset(unsigned int n)
+		{
+			tree_adj.assign(n, set<unsigned int>());
+			non_tree_adj.assign(n, map<unsigned int, unsigned int>());
+			component.resize(n);
+			component_size.assign(n, 1);
+			component_root.resize(n);
+			free_ids.clear();
+			num_components = n;
+			seen.reset(n);
+
+			for(unsigned int i = 0; i < n; i++)
+			{
+				component[i] = component_root[i] = i;
+			}
+		}
+
+		// Adds an isolated vertex and returns it
+		unsigned int add()
+		{
+			unsigned int vertex = component.size();
+
+			tree_adj.push_back(set<unsigned int>());
+			non_tree_adj.push_back(map<unsigned int, unsigned int>());
+			component.push_back(newComponent(vertex, 1));
+			seen.resize(seen.size() + 1);
+
+			return vertex;
+		}
+
+		// Removes the vertex along with its edges, the last vertex is renumbered to take its place
+		void remove(unsigned int vertex)
+		{
+			const unsigned int last = component.size() - 1;
+
+			while(!non_tree_adj[vertex].empty())
+			{
+				unsigned int w = non_tree_adj[vertex].begin()->first;
+
+				non_tree_adj[w].erase(vertex);
+				non_tree_adj[vertex].erase(w);
+			}
+
+			while(!tree_adj[vertex].empty())
+			{
+				cutTreeEdge(vertex, *tree_adj[vertex].begin());
+			}
+
+			freeComponent(component[vertex]);
+
+			if(vertex != last)
+			{
+				renumber(last, vertex);
+			}
+
+			tree_adj.pop_back();
+			non_tree_adj.pop_back();
+			component.pop_back();
+			seen.resize(seen.size() - 1);
+		}
+
+		void insertEdge(unsigned int u, unsigned int v)
+		{
+			if(u == v)	// Self loops do not affect connectivity
+			{
+				return;
+			}
+
+			unsigned int cu = component[u], cv = component[v];
+
+			if(cu == cv)
+			{
+				addNonTreeEdge(u, v, 1);
+				return;
+			}
+
+			// The smaller tree is relabelled
+			if(component_size[cu] > component_size[cv])
+			{
+				swap(u, v);
+				swap(cu, cv);
+			}
+
+			vector<unsigned int> relabelled;
+
+			collectTree(u, relabelled, cv);
+			component_size[cv] += component_size[cu];
+			freeComponent(cu);
+
+			tree_adj[u].insert(v);
+			tree_adj[v].insert(u);
+		}
+
+		// Deletes one copy of the edge, non tree copies are preferred
+		void deleteEdge(unsigned int u, unsigned int v)
+		{
+			if(u == v)
+			{
+				return;
+			}
+
+			if(removeNonTreeEdge(u, v))
+			{
+				return;
+			}
+
+			if(tree_adj[u].find(v) != tree_adj[u].end())
+			{
+				cutTreeEdge(u, v);
+			}
+		}
+
+		// Some fixed vertex of the component, as long as the component is not modified
+		unsigned int find(unsigned int vertex) const
+		{
+			return component_root[component[vertex]];
+		}
+
+		bool connected(unsigned int u, unsigned int v) const
+		{
+			return component[u] == component[v];
+		}
+
+		unsigned int numElements() const
+		{
+			return component.size();
+		}
+
+		unsigned int numSets() const
+		{
+			return num_components;
+		}
+};
+
+#endif
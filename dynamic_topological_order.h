@@ -0,0 +1,339 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _DYNAMIC_TOPOLOGICAL_ORDER_H
+#define _DYNAMIC_TOPOLOGICAL_ORDER_H
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <vector>
+
+#include "stamped_marks.h"
+
+using namespace std;
+
+/**
+	Topological order of a directed acyclic multigraph over the vertices 0 .. n-1, under insertion and deletion of edges.
+
+	Every vertex holds a distinct position. An edge u -> v which already agrees with the positions is just
+	recorded. Otherwise (Pearce and Kelly) the vertices reachable from v with positions up to u's, and the
+	vertices reaching u with positions from v's, are the only ones out of place: they are searched, and
+	their positions are handed out again, the ones reaching u first. Reaching u from v means that the
+	edge closes a cycle, and it is refused. Deletions and removals never break the order.
+**/
+class DynamicTopologicalOrder
+{
+	private:
+		vector<map<unsigned int, unsigned int> > out_adj, in_adj;	// Neighbour -> multiplicity
+		
+		vector<unsigned int> position;
+		vector<int> vertex_at;	// Indexed by the position, -1 for the positions freed by the removed vertices
+		unsigned int num_free;
+		
+		StampedMarks seen;	// Marks of the searches
+		
+		// Vertices reachable from start without going past the position bound. Returns false if target is among them
+		bool searchForward(unsigned int start, unsigned int bound, unsigned int target, vector<unsigned int> &res)
+		{
+			unsigned int st = seen.next();
+			
+			res.clear();
+			res.push_back(start);
+			seen.mark(start, st);
+			
+			for(unsigned int i = 0; i < res.size(); i++)
+			{
+				for(map<unsigned int, unsigned int>::const_iterator w = out_adj[res[i]].begin(); w != out_adj[res[i]].end(); w++)
+				{
+					if(w->first == target)
+					{
+						return false;
+					}
+					
+					if(!seen.marked(w->first, st) && position[w->first] < bound)
+					{
+						seen.mark(w->first, st);
+						res.push_back(w->first);
+					}
+				}
+			}
+			
+			return true;
+		}
+		
+		// Vertices reaching start without going below the position bound
+		void searchBackward(unsigned int start, unsigned int bound, vector<unsigned int> &res)
+		{
+			unsigned int st = seen.next();
+			
+			res.clear();
+			res.push_back(start);
+			seen.mark(start, st);
+			
+			for(unsigned int i = 0; i < res.size(); i++)
+			{
+				for(map<unsigned int, unsigned int>::const_iterator w = in_adj[res[i]].begin(); w != in_adj[res[i]].end(); w++)
+				{
+					if(!seen.marked(w->first, st) && position[w->first] > bound)
+					{
+						seen.mark(w->first, st);
+						res.push_back(w->first);
+					}
+				}
+			}
+		}
+		
+		class ByPosition
+		{
+			const vector<unsigned int> &position;
+			
+			public:
+				ByPosition(const vector<unsigned int> &position) : position(position)
+				{
+				}
+				
+				bool operator()(unsigned int v1, unsigned int v2) const
+				{
+					return position[v1] < position[v2];
+				}
+		};
+		
+		// The positions held by both the sets are given out again, to the backward set first
+		void reorder(vector<unsigned int> &backward, vector<unsigned int> &forward)
+		{
+			vector<unsigned int> slots;
+			
+			sort(backward.begin(), backward.end(), ByPosition(position));
+			sort(forward.begin(), forward.end(), ByPosition(position));
+			
+			for(unsigned int i = 0; i < backward.size(); i++)
+			{
+				slots.push_back(position[backward[i]]);
+			}
+			
+			for(unsigned int i = 0; i < forward.size(); i++)
+			{
+				slots.push_back(position[forward[i]]);
+			}
+			
+			inplace_merge(slots.begin(), slots.begin() + backward.size(), slots.end());
+			
+			backward.insert(backward.end(), forward.begin(), forward.end());
+			
+			for(unsigned int i = 0; i < backward.size(); i++)
+			{
+				position[backward[i]] = slots[i];
+				vertex_at[slots[i]] = backward[i];
+			}
+		}
+		
+		// Squeezes out the freed positions
+		void compact()
+		{
+			vector<int> packed;
+			
+			packed.reserve(position.size());
+			
+			for(unsigned int p = 0; p < vertex_at.size(); p++)
+			{
+				if(vertex_at[p] != -1)
+				{
+					position[vertex_at[p]] = packed.size();
+					packed.push_back(vertex_at[p]);
+				}
+			}
+			
+			vertex_at.swap(packed);
+			num_free = 0;
+		}
+		
+		// Moves vertex from into the slot to, both in its own arcs and in the arcs of its neighbours pointing back at it
+		void renumber(unsigned int from, unsigned int to)
+		{
+			for(map<unsigned int, unsigned int>::const_iterator w = out_adj[from].begin(); w != out_adj[from].end(); w++)
+			{
+				in_adj[w->first].erase(from);
+				in_adj[w->first][to] = w->second;
+			}
+			
+			for(map<unsigned int, unsigned int>::const_iterator w = in_adj[from].begin(); w != in_adj[from].end(); w++)
+			{
+				out_adj[w->first].erase(from);
+				out_adj[w->first][to] = w->second;
+			}
+			
+			out_adj[to].swap(out_adj[from]);
+			in_adj[to].swap(in_adj[from]);
+			position[to] = position[from];
+			vertex_at[position[to]] = to;
+			seen.move(from, to);
+		}
+		
+	public:
+		DynamicTopologicalOrder() : num_free(0)
+		{
+		}
+		
+		// Starts over without edges, with the vertices 0 .. order.size()-1 placed in the given order
+		void reset(const vector<unsigned int> &order)
+		{
+			const unsigned int n = order.size();
+			
+			out_adj.assign(n, map<unsigned int, unsigned int>());
+			in_adj.assign(n, map<unsigned int, unsigned int>());
+			position.resize(n);
+			vertex_at.assign(order.begin(), order.end());
+			num_free = 0;
+			seen.reset(n);
+			
+			for(unsigned int p = 0; p < n; p++)
+			{
+				position[order[p]] = p;
+			}
+		}
+		
+		// Adds an isolated vertex at the end of the order and returns it
+		unsigned int add()
+		{
+			unsigned int vertex = position.size();
+			
+			out_adj.push_back(map<unsigned int, unsigned int>());
+			in_adj.push_back(map<unsigned int, unsigned int>());
+			position.push_back(vertex_at.size());
+			vertex_at.push_back(vertex);
+			seen.resize(seen.size() + 1);
+			
+			return vertex;
+		}
+		
+		// Drops the vertex, its arcs in both the directions and its position in the order. The last vertex moves into its slot
+		void remove(unsigned int vertex)
+		{
+			const unsigned int last = position.size() - 1;
+			
+			for(map<unsigned int, unsigned int>::const_iterator w = out_adj[vertex].begin(); w != out_adj[vertex].end(); w++)
+			{
+				in_adj[w->first].erase(vertex);
+			}
+			
+			for(map<unsigned int, unsigned int>::const_iterator w = in_adj[vertex].begin(); w != in_adj[vertex].end(); w++)
+			{
+				out_adj[w->first].erase(vertex);
+			}
+			
+			out_adj[vertex].clear();
+			in_adj[vertex].clear();
+			vertex_at[position[vertex]] = -1;
+			num_free++;
+			
+			if(vertex != last)
+			{
+				renumber(last, vertex);
+			}
+			
+			out_adj.pop_back();
+			in_adj.pop_back();
+			position.pop_back();
+			seen.resize(seen.size() - 1);
+			
+			if(2 * num_free > vertex_at.size())
+			{
+				compact();
+			}
+		}
+		
+		// Returns false, without inserting it, if the edge would close a cycle
+		bool insertEdge(unsigned int u, unsigned int v)
+		{
+			if(u == v)
+			{
+				return false;
+			}
+			
+			if(position[v] < position[u])
+			{
+				vector<unsigned int> forward, backward;
+				
+				if(!searchForward(v, position[u], u, forward))
+				{
+					return false;
+				}
+				
+				searchBackward(u, position[v], backward);
+				reorder(backward, forward);
+			}
+			
+			out_adj[u][v]++;
+			in_adj[v][u]++;
+			
+			return true;
+		}
+		
+		// Deletes one copy of the edge
+		void deleteEdge(unsigned int u, unsigned int v)
+		{
+			map<unsigned int, unsigned int>::iterator uv = out_adj[u].find(v);
+			
+			if(uv == out_adj[u].end())
+			{
+				return;
+			}
+			
+			if(--(uv->second) == 0)
+			{
+				out_adj[u].erase(uv);
+				in_adj[v].erase(u);
+			}
+			else
+			{
+				in_adj[v][u]--;
+			}
+		}
+		
+		bool precedes(unsigned int u, unsigned int v) const
+		{
+			return position[u] < position[v];
+		}
+		
+		// Vertices from the first to the last
+		vector<unsigned int> order() const
+		{
+			vector<unsigned int> res;
+			
+			res.reserve(position.size());
+			
+			for(unsigned int p = 0; p < vertex_at.size(); p++)
+			{
+				if(vertex_at[p] != -1)
+				{
+					res.push_back(vertex_at[p]);
+				}
+			}
+			
+			return res;
+		}
+		
+		unsigned int numElements() const
+		{
+			return position.size();
+		}
+};
+
+#endif
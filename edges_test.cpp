@@ -0,0 +1,136 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+bool byEndpoints(const Edge<int> &e1, const Edge<int> &e2)
+{
+	return (e1.src < e2.src) || ((e1.src == e2.src) && ((e1.dest < e2.dest) || ((e1.dest == e2.dest) && (e1.cost < e2.cost))));
+}
+
+int main()
+{
+	Graph<char> g(false);
+	
+	for(char c = 'a'; c <= 'd'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('a', 'b', 3);
+	g.addEdge('b', 'a', 4);
+	g.addEdge('c', 'b', 1);
+	g.addEdge('d', 'd', 2);
+	g.addEdge('a', 'd', 6);
+	
+	cout << "Range:" << endl;
+	for(Edge<char> e : g.edges())
+	{
+		cout << e;
+	}
+	
+	cout << "Costs through the callback:";
+	g.forEachEdge([](const char &src, const char &dest, int cost)
+	{
+		cout << " " << src << dest << "=" << cost;
+	});
+	cout << endl;
+	
+	vector<Edge<char> > buffer;
+	
+	g.exportEdges(buffer);
+	
+	// A copy and an assignment keep both the endpoints
+	Edge<char> copied(buffer[0]), assigned('x', 'y', 0);
+	
+	assigned = buffer[1];
+	
+	cout << "Exported " << buffer.size() << " edges, copied " << copied.src << copied.dest << ", assigned " << assigned.src << assigned.dest << endl;
+	
+	Edge<char> picked('x', 'y', 0);
+	
+	srand(1);
+	cout << "Picked an edge: " << g.pickRandomEdge(picked) << ", " << g.edgeExists(picked.src, picked.dest, picked.cost) << endl;
+	
+	// Random multigraphs, the streamed edges must be those of getEdges()
+	for(int directed = 0; directed <= 1; directed++)
+	{
+		Graph<int> r(directed);
+		const int n = 200;
+		
+		srand(17 + directed);
+		
+		for(int i = 0; i < n; i++)
+		{
+			r.addVertex(i);
+		}
+		
+		for(int i = 0; i < 5 * n; i++)
+		{
+			r.addEdge(rand() % n, rand() % n, rand() % 10);
+		}
+		
+		vector<Edge<int> *> allocated = r.getEdges();
+		vector<Edge<int> > expected, streamed, ranged, exported;
+		
+		for(unsigned int i = 0; i < allocated.size(); i++)
+		{
+			// getEdges() lists an undirected edge from both the endpoints
+			if(directed || allocated[i]->src <= allocated[i]->dest)
+			{
+				expected.push_back(*allocated[i]);
+			}
+			
+			delete allocated[i];
+		}
+		
+		r.forEachEdge([&streamed](const int &src, const int &dest, int cost)
+		{
+			streamed.push_back(Edge<int>(src, dest, cost));
+		});
+		
+		for(Graph<int>::EdgeIterator itr = r.edges().begin(); itr != r.edges().end(); ++itr)
+		{
+			ranged.push_back(Edge<int>(itr->src, itr->dest, itr->cost));
+		}
+		
+		r.exportEdges(exported);
+		
+		sort(expected.begin(), expected.end(), byEndpoints);
+		sort(streamed.begin(), streamed.end(), byEndpoints);
+		
+		bool same = (expected.size() == streamed.size()) && (streamed.size() == ranged.size()) && (ranged.size() == exported.size());
+		
+		for(unsigned int i = 0; same && i < expected.size(); i++)
+		{
+			same = !byEndpoints(expected[i], streamed[i]) && !byEndpoints(streamed[i], expected[i]);
+			same = same && (ranged[i].src == exported[i].src) && (ranged[i].dest == exported[i].dest) && (ranged[i].cost == exported[i].cost);
+		}
+		
+		cout << (directed? "Directed": "Undirected") << " random multigraph: " << expected.size() << " edges, " << (same? "same": "different") << " edges streamed" << endl;
+	}
+	
+	return 0;
+}
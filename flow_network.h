@@ -0,0 +1,481 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _FLOW_NETWORK_H
+#define _FLOW_NETWORK_H
+
+#include <algorithm>
+#include <cassert>
+#include <queue>
+#include <vector>
+
+using namespace std;
+
+enum MaxFlowAlgorithm
+{
+	DINIC,	// Blocking flows over BFS level graphs
+	PUSH_RELABEL	// Highest label first
+};
+
+/**
+	Residual network over the vertices 0 .. n-1, with the arcs of every vertex stored contiguously.
+
+	Every edge is an arc with its paired reverse arc. Edges are added first and build() lays them out,
+	after which either engine can be run once. Both the engines leave the residual capacities behind,
+	from which sourceSide() reads a minimum cut.
+**/
+class FlowNetwork
+{
+	private:
+		struct PendingEdge
+		{
+			unsigned int src, dest;
+			long long cap, rev_cap;
+		};
+
+		unsigned int n;
+		vector<PendingEdge> pending;
+
+		vector<unsigned int> first;	// Arcs of v are first[v] .. first[v+1]-1
+		vector<unsigned int> head;
+		vector<unsigned int> rev;	// Paired arc in the opposite direction
+		vector<long long> cap;	// Residual capacity
+
+		vector<int> level;
+		vector<unsigned int> cur;	// Current arc of every vertex
+
+		bool dinicLevels(unsigned int source, unsigned int sink)
+		{
+			queue<unsigned int> q;
+
+			level.assign(n, -1);
+			level[source] = 0;
+			q.push(source);
+
+			while(!q.empty())
+			{
+				unsigned int v = q.front();
+				q.pop();
+
+				for(unsigned int a = first[v]; a < first[v + 1]; a++)
+				{
+					if(cap[a] > 0 && level[head[a]] == -1)
+					{
+						level[head[a]] = level[v] + 1;
+						q.push(head[a]);
+					}
+				}
+			}
+
+			return level[sink] != -1;
+		}
+
+		// Blocking flow of the level graph, the augmenting path is kept as a stack of arcs instead of recursing
+		long long dinicBlockingFlow(unsigned int source, unsigned int sink)
+		{
+			long long flow = 0;
+			vector<unsigned int> path;
+			unsigned int v = source;
+
+			cur.assign(first.begin(), first.end() - 1);
+
+			while(true)
+			{
+				if(v == sink)
+				{
+					long long bottleneck = cap[path[0]];
+					unsigned int saturated = 0;
+
+					for(unsigned int i = 1; i < path.size(); i++)
+					{
+						if(cap[path[i]] < bottleneck)
+						{
+							bottleneck = cap[path[i]];
+							saturated = i;
+						}
+					}
+
+					for(unsigned int i = 0; i < path.size(); i++)
+					{
+						cap[path[i]] -= bottleneck;
+						cap[rev[path[i]]] += bottleneck;
+					}
+
+					flow += bottleneck;
+
+					// Resume from the tail of the first saturated arc
+					v = head[rev[path[saturated]]];
+					path.resize(saturated);
+
+					continue;
+				}
+
+				while(cur[v] < first[v + 1] && !(cap[cur[v]] > 0 && level[head[cur[v]]] == level[v] + 1))
+				{
+					cur[v]++;
+				}
+
+				if(cur[v] < first[v + 1])
+				{
+					path.push_back(cur[v]);
+					v = head[cur[v]];
+
+					continue;
+				}
+
+				// Dead end, it is pruned from the level graph and the search backs off by one arc
+				if(v == source)
+				{
+					return flow;
+				}
+
+				level[v] = -1;
+				v = head[rev[path.back()]];
+				path.pop_back();
+				cur[v]++;
+			}
+		}
+
+		// Push relabel state
+		vector<unsigned int> height;
+		vector<long long> excess;
+		vector<int> active_head, active_next;	// Active vertices of every height, as stacks
+		vector<int> all_head, all_next, all_prev;	// All the vertices of every height below n, for the gap heuristic
+		int max_active, max_all;
+
+		void addActive(unsigned int v)
+		{
+			active_next[v] = active_head[height[v]];
+			active_head[height[v]] = v;
+			max_active = max(max_active, (int) height[v]);
+		}
+
+		void addToHeight(unsigned int v)
+		{
+			unsigned int h = height[v];
+
+			all_prev[v] = -1;
+			all_next[v] = all_head[h];
+
+			if(all_head[h] != -1)
+			{
+				all_prev[all_head[h]] = v;
+			}
+
+			all_head[h] = v;
+			max_all = max(max_all, (int) h);
+		}
+
+		void removeFromHeight(unsigned int v)
+		{
+			if(all_prev[v] != -1)
+			{
+				all_next[all_prev[v]] = all_next[v];
+			}
+			else
+			{
+				all_head[height[v]] = all_next[v];
+			}
+
+			if(all_next[v] != -1)
+			{
+				all_prev[all_next[v]] = all_prev[v];
+			}
+		}
+
+		// Exact distances to the sink by a backward breadth first search, vertices that cannot reach it are lifted to n
+		void globalRelabel(unsigned int source, unsigned int sink)
+		{
+			queue<unsigned int> q;
+
+			height.assign(n, n);
+			height[sink] = 0;
+			q.push(sink);
+
+			while(!q.empty())
+			{
+				unsigned int w = q.front();
+				q.pop();
+
+				for(unsigned int a = first[w]; a < first[w + 1]; a++)
+				{
+					unsigned int u = head[a];
+
+					if(cap[rev[a]] > 0 && height[u] == n && u != sink)
+					{
+						height[u] = height[w] + 1;
+						q.push(u);
+					}
+				}
+			}
+
+			height[source] = n;
+
+			active_head.assign(n + 1, -1);
+			all_head.assign(n + 1, -1);
+			max_active = max_all = -1;
+
+			for(unsigned int v = 0; v < n; v++)
+			{
+				if(v != source && v != sink && height[v] < n)
+				{
+					addToHeight(v);
+
+					if(excess[v] > 0)
+					{
+						addActive(v);
+					}
+				}
+
+				cur[v] = first[v];
+			}
+		}
+
+		// Every vertex above the emptied height can no longer reach the sink
+		void gap(unsigned int empty_height)
+		{
+			for(int h = empty_height + 1; h <= max_all; h++)
+			{
+				for(int v = all_head[h]; v != -1; v = all_next[v])
+				{
+					height[v] = n;
+				}
+
+				all_head[h] = -1;
+			}
+
+			max_all = empty_height - 1;
+		}
+
+	public:
+		FlowNetwork(unsigned int n) : n(n)
+		{
+		}
+
+		void addEdge(unsigned int src, unsigned int dest, long long capacity, long long reverse_capacity = 0)
+		{
+			PendingEdge e;
+
+			e.src = src;
+			e.dest = dest;
+			e.cap = capacity;
+			e.rev_cap = reverse_capacity;
+
+			pending.push_back(e);
+		}
+
+		void build()
+		{
+			const unsigned int m = 2 * pending.size();
+			vector<unsigned int> pos(n + 1, 0);
+
+			first.assign(n + 1, 0);
+			head.resize(m);
+			rev.resize(m);
+			cap.resize(m);
+
+			for(unsigned int i = 0; i < pending.size(); i++)
+			{
+				first[pending[i].src + 1]++;
+				first[pending[i].dest + 1]++;
+			}
+
+			for(unsigned int v = 0; v < n; v++)
+			{
+				first[v + 1] += first[v];
+			}
+
+			pos.assign(first.begin(), first.end());
+
+			for(unsigned int i = 0; i < pending.size(); i++)
+			{
+				unsigned int a = pos[pending[i].src]++;
+				unsigned int b = pos[pending[i].dest]++;
+
+				head[a] = pending[i].dest;
+				cap[a] = pending[i].cap;
+				rev[a] = b;
+
+				head[b] = pending[i].src;
+				cap[b] = pending[i].rev_cap;
+				rev[b] = a;
+			}
+
+			pending.clear();
+		}
+
+		long long dinic(unsigned int source, unsigned int sink)
+		{
+			long long flow = 0;
+
+			while(dinicLevels(source, sink))
+			{
+				flow += dinicBlockingFlow(source, sink);
+			}
+
+			return flow;
+		}
+
+		// Highest label push relabel with the gap and global relabelling heuristics.
+		// Only the first phase is run: it gives the value of the maximum flow and the minimum cut, not the flow itself
+		long long pushRelabel(unsigned int source, unsigned int sink)
+		{
+			const unsigned long long relabel_period = 6ULL * n + head.size() / 2;
+			unsigned long long work = 0;
+
+			excess.assign(n, 0);
+			active_next.assign(n, -1);
+			all_next.assign(n, -1);
+			all_prev.assign(n, -1);
+			cur.assign(n, 0);
+
+			for(unsigned int a = first[source]; a < first[source + 1]; a++)
+			{
+				excess[head[a]] += cap[a];
+				excess[source] -= cap[a];
+				cap[rev[a]] += cap[a];
+				cap[a] = 0;
+			}
+
+			globalRelabel(source, sink);
+
+			while(max_active >= 0)
+			{
+				int v = active_head[max_active];
+
+				if(v == -1)
+				{
+					max_active--;
+					continue;
+				}
+
+				active_head[max_active] = active_next[v];
+
+				// Lifted out by a gap after it was activated
+				if(height[v] >= n)
+				{
+					continue;
+				}
+
+				while(excess[v] > 0)
+				{
+					for(; cur[v] < first[v + 1] && excess[v] > 0; cur[v]++)
+					{
+						unsigned int a = cur[v], w = head[a];
+
+						if(cap[a] > 0 && height[v] == height[w] + 1)
+						{
+							long long delta = min(excess[v], cap[a]);
+
+							if(excess[w] == 0 && w != sink)
+							{
+								addActive(w);
+							}
+
+							cap[a] -= delta;
+							cap[rev[a]] += delta;
+							excess[v] -= delta;
+							excess[w] += delta;
+
+							if(excess[v] == 0)
+							{
+								break;
+							}
+						}
+					}
+
+					if(excess[v] == 0)
+					{
+						break;
+					}
+
+					// Relabel
+					unsigned int old_height = height[v], new_height = 2 * n;
+
+					for(unsigned int a = first[v]; a < first[v + 1]; a++)
+					{
+						if(cap[a] > 0)
+						{
+							new_height = min(new_height, height[head[a]] + 1);
+						}
+					}
+
+					work += first[v + 1] - first[v] + 12;
+					removeFromHeight(v);
+
+					if(all_head[old_height] == -1)
+					{
+						height[v] = n;
+						gap(old_height);
+						break;
+					}
+
+					height[v] = new_height;
+					cur[v] = first[v];
+
+					if(new_height >= n)
+					{
+						break;
+					}
+
+					addToHeight(v);
+
+					if(work > relabel_period)
+					{
+						work = 0;
+						globalRelabel(source, sink);
+						break;
+					}
+				}
+			}
+
+			return excess[sink];
+		}
+
+		// Vertices from which the sink cannot be reached in the residual network
+		vector<bool> sourceSide(unsigned int sink) const
+		{
+			vector<bool> reaches(n, false);
+			queue<unsigned int> q;
+
+			reaches[sink] = true;
+			q.push(sink);
+
+			while(!q.empty())
+			{
+				unsigned int w = q.front();
+				q.pop();
+
+				for(unsigned int a = first[w]; a < first[w + 1]; a++)
+				{
+					if(cap[rev[a]] > 0 && !reaches[head[a]])
+					{
+						reaches[head[a]] = true;
+						q.push(head[a]);
+					}
+				}
+			}
+
+			reaches.flip();
+
+			return reaches;
+		}
+};
+
+#endif
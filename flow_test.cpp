@@ -0,0 +1,143 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include "graph.h"
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+template <class T>
+void printCut(const pair<long long, pair<vector<T>, vector<T> > > &res)
+{
+	cout << "Max-flow: " << res.first << ", cut: { ";
+	
+	for(unsigned int i = 0; i < res.second.first.size(); i++)
+	{
+		cout << res.second.first[i] << " ";
+	}
+	
+	cout << "} { ";
+	
+	for(unsigned int i = 0; i < res.second.second.size(); i++)
+	{
+		cout << res.second.second[i] << " ";
+	}
+	
+	cout << "}" << endl;
+}
+
+int main()
+{
+	// Flow network from Cormen et al.
+	Graph<char> g(true);
+	
+	g.addVertex('s');
+	g.addVertex('a');
+	g.addVertex('b');
+	g.addVertex('c');
+	g.addVertex('d');
+	g.addVertex('t');
+	
+	g.addEdge('s', 'a', 16);
+	g.addEdge('s', 'b', 13);
+	g.addEdge('a', 'c', 12);
+	g.addEdge('b', 'a', 4);
+	g.addEdge('b', 'd', 14);
+	g.addEdge('c', 'b', 9);
+	g.addEdge('c', 't', 20);
+	g.addEdge('d', 'c', 7);
+	g.addEdge('d', 't', 4);
+	
+	cout << "Dinic: ";
+	printCut(g.maxFlow('s', 't'));
+	cout << "Push-relabel: ";
+	printCut(g.maxFlow('s', 't', PUSH_RELABEL));
+	
+	cout << "Reversed: " << g.maxFlow('t', 's').first << endl;
+	cout << "Unknown sink: " << g.maxFlow('s', 'x').first << endl;
+	
+	// Undirected edges carry flow in either direction
+	Graph<int> u(false);
+	
+	for(int i = 1; i <= 4; i++)
+	{
+		u.addVertex(i);
+	}
+	
+	u.addEdge(1, 2, 3);
+	u.addEdge(1, 3, 2);
+	u.addEdge(2, 3, 5);
+	u.addEdge(2, 4, 2);
+	u.addEdge(3, 4, 3);
+	
+	cout << "Undirected: ";
+	printCut(u.maxFlow(1, 4, PUSH_RELABEL));
+	
+	// Both the engines agree on random networks, and the cut has the capacity of the flow
+	srand(7);
+	bool agree = true;
+	
+	for(int trial = 0; trial < 50; trial++)
+	{
+		Graph<int> r(trial % 2 == 0);
+		int n = 2 + rand() % 40;
+		
+		for(int i = 0; i < n; i++)
+		{
+			r.addVertex(i);
+		}
+		
+		for(int i = 4 * n; i > 0; i--)
+		{
+			r.addEdge(rand() % n, rand() % n, rand() % 10);
+		}
+		
+		pair<long long, pair<vector<int>, vector<int> > > dinic = r.maxFlow(0, n - 1);
+		pair<long long, pair<vector<int>, vector<int> > > pr = r.maxFlow(0, n - 1, PUSH_RELABEL);
+		
+		set<int> side(pr.second.first.begin(), pr.second.first.end());
+		long long capacity = 0;
+		
+		for(int i = 0; i < n; i++)
+		{
+			for(int j = 0; j < n; j++)
+			{
+				if(side.count(i) && !side.count(j))
+				{
+					vector<int> costs = r.edgeCosts(i, j);
+					
+					for(unsigned int k = 0; k < costs.size(); k++)
+					{
+						capacity += costs[k];
+					}
+				}
+			}
+		}
+		
+		if(dinic.first != pr.first || capacity != pr.first || !side.count(0) || side.count(n - 1))
+		{
+			agree = false;
+		}
+	}
+	
+	cout << "Engines agree on random networks: " << agree << endl;
+	
+	return 0;
+}
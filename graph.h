@@ -20,7 +20,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 /**
 	YET TO BE IMPLEMENTED
 	-------------------------
-	Krushkal's algorithm
 	Euler's path
 	Euler's circuit
 	Hamiltonean path
@@ -32,7 +31,6 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 	isPlanar()
 	Bipartite Matching problem (Hungarian algorithm)
 	Graph coloring problem
-	Cycle detection
 	Finding articulation points
 	Cut Vertex
 	Cut Set
@@ -49,24 +47,41 @@ Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
 #define _GRAPH_H
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <climits>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <stack>
 #include <vector>
 
+#include "bit_matrix.h"
+#include "dense_matrix.h"
 #include "disjoint_set.h"
+#include "dynamic_connectivity.h"
+#include "dynamic_topological_order.h"
+#include "flow_network.h"
+#include "hop_label_index.h"
+#include "node_pool.h"
+#include "parallel.h"
+#include "prng.h"
+#include "reachability_index.h"
+#include "sparse_matrix.h"
 
 using namespace std;
 
 #define NOT_A_DIRECTED_GRAPH "Not a directed graph"
 #define NOT_AN_ACYCLIC_GRAPH "Not an acyclic graph"
+#define KARGER_STEIN_EXACT 8 // Graphs with at most these many vertices are cut exactly
+#define REACHABILITY_INTERVALS 3 // Interval labels per vertex in the reachability index
 // #define DEBUG
 
 template <class T>
@@ -80,16 +95,17 @@ class Edge
 		{
 		}
 		
-		Edge(const Edge &e)
+		Edge(const Edge &e) : src(e.src), dest(e.dest), cost(e.cost)
 		{
-			this->operator=(e);
 		}
 		
-		void operator=(const Edge &e)
+		Edge & operator=(const Edge &e)
 		{
 			src = e.src;
-			dest = e.src;
+			dest = e.dest;
 			cost = e.cost;
+			
+			return *this;
 		}
 		 
 		friend ostream& operator<<(ostream &out, Edge<T> &e)
@@ -104,29 +120,134 @@ class Graph
 {
 	private:
 	
+		// The other end of an edge by its position in indexed_vertices, with the cost of the edge.
+		// The tree nodes come from the node pool of the graph, if it has one
+		typedef multiset<pair<unsigned int, int>, less<pair<unsigned int, int> >, PoolAllocator<pair<unsigned int, int> > > Adjacency;
+		
+		// Counted reference to an edge set, the copies of a vertex made in copy on write mode hold the same set.
+		// A holder lets go with release ordering and unique() reads the count with acquire ordering, so a copy which finds
+		// itself the only holder and writes in place comes after every read of the others, even from other threads
+		class SharedAdjacency
+		{
+			private:
+				struct Block
+				{
+					atomic<unsigned int> refs;
+					Adjacency edges;
+					
+					Block(const Adjacency &edges, NodePool *pool) : refs(1), edges(edges, PoolAllocator<pair<unsigned int, int> >(pool))
+					{
+					}
+				};
+				
+				Block *block;
+				
+				void release()
+				{
+					if(block->refs.fetch_sub(1, memory_order_acq_rel) == 1)
+					{
+						NodePool *pool = block->edges.get_allocator().getPool();
+						
+						block->~Block();
+						
+						if(pool)
+						{
+							pool->deallocate(block, sizeof(Block));
+						}
+						else
+						{
+							::operator delete(block);
+						}
+					}
+				}
+				
+			public:
+				// A copy of edges, in the pool given or on the heap
+				SharedAdjacency(const Adjacency &edges, NodePool *pool)
+				{
+					block = new(pool? pool->allocate(sizeof(Block)): ::operator new(sizeof(Block))) Block(edges, pool);
+				}
+				
+				// A copy of edges, in the pool of edges
+				SharedAdjacency(const Adjacency &edges) : SharedAdjacency(edges, edges.get_allocator().getPool())
+				{
+				}
+				
+				SharedAdjacency(const SharedAdjacency &s) : block(s.block)
+				{
+					block->refs.fetch_add(1, memory_order_relaxed);
+				}
+				
+				~SharedAdjacency()
+				{
+					release();
+				}
+				
+				SharedAdjacency & operator=(const SharedAdjacency &s)
+				{
+					s.block->refs.fetch_add(1, memory_order_relaxed);
+					release();
+					block = s.block;
+					
+					return *this;
+				}
+				
+				Adjacency & operator*() const
+				{
+					return block->edges;
+				}
+				
+				Adjacency * operator->() const
+				{
+					return &block->edges;
+				}
+				
+				bool unique() const
+				{
+					return block->refs.load(memory_order_acquire) == 1;
+				}
+		};
+	
 		class Vertex
 		{
 			private:
 				T label;
-				multiset<pair<Vertex *, int> > adj;
-				multiset<Vertex *> rev; // This is maintained to remove edges that incident on a removed vertex. It also helps to find the indegree of a vertex
+				unsigned int index; // Position of the vertex in Graph<T>::indexed_vertices
 				
-				typename multiset<pair<Vertex *, int> >::iterator findAdjacent(Vertex *dest) const;
+				// Copies of the graph made in copy on write mode share these, a shared set is copied before it is modified
+				SharedAdjacency adj;
+				SharedAdjacency rev; // Incoming edges with their costs, the other end being the source. It is used to remove the edges of a removed vertex and to walk the edges backwards
+				
+				static SharedAdjacency newAdjacency(NodePool *pool);
+				static Adjacency & own(SharedAdjacency &edges);
+				static vector<int> takeEntries(SharedAdjacency &edges, unsigned int w);
+				typename Adjacency::const_iterator findAdjacent(unsigned int dest) const;
 	
 			public:
-				Vertex(T label);
-				~Vertex();
+				Vertex(T label, NodePool *pool);
+				Vertex(const Vertex &v, bool share, bool transpose, NodePool *pool);
 	
 				void setLabel(T label);
 				T getLabel() const;
+				
+				void setIndex(unsigned int index);
+				unsigned int getIndex() const;
 	
-				multiset<pair<Vertex *, int> > getAdjacentNodes() const;
-				multiset<Vertex *> getReverseNodes() const;
+				const Adjacency & adjacency() const;
+				const Adjacency & reverseAdjacency() const;
+				bool sharesEdges() const;
 	
 				void addEdge(Vertex *dest, int cost);
 				bool removeEdge(Vertex *dest, int cost);
 				bool removeEdge(Vertex *dest);
-				void addEdgesInBatch(multiset<pair<Vertex *, int> > new_adj);
+				vector<int> removeEdgesTo(unsigned int dest);
+				void removeIncoming(unsigned int src);
+				void removeIncoming(unsigned int src, int cost);
+				void clearEdges();
+				void appendEdge(unsigned int dest, int cost);
+				void appendIncoming(unsigned int src, int cost);
+				void simplify(vector<pair<unsigned int, int> > &removed);
+				void renumberNeighbour(unsigned int from, unsigned int to);
 				
 				bool edgeExists(Vertex *dest) const;
 				bool edgeExists(Vertex *dest, int cost) const;
@@ -141,39 +262,230 @@ class Graph
 				int outdegree() const;
 				
 				bool hasNegativeWeightedEdge() const;
-	
-				void addIncomingEdges(Vertex *dest);
-				
-				friend ostream& operator<<(ostream& out, Vertex &v)
-				{
-					out << v.label << " --->  ";
-				
-					for(typename multiset<pair<Vertex *, int> >::iterator itr = v.adj.begin(); itr != v.adj.end(); itr++)
-					{
-						out << itr->first->getLabel() << "(" << itr->second << "), ";
-					}
-				
-					out << "\b\b " << endl;
-					
-					return out;
-				}
 		};
 
+		// The other ends of the edges of a vertex as pointers, for the algorithms that work on the labels
+		typedef vector<pair<Vertex *, int> > Neighbours;
+		
+		// Edge between two densely indexed vertices, used by the array based algorithms
+		struct FlatEdge
+		{
+			unsigned int src, dest;
+			int cost;
+			
+			bool operator<(const FlatEdge &e) const
+			{
+				return cost < e.cost;
+			}
+		};
+		
+		// Memory of the vertices and of their edge sets, shared with the copies of the graph which share its edges.
+		// It is declared first so it is released last. Without one they come from the heap
+		shared_ptr<NodePool> pool;
+		
 		map<T, Vertex *> vertices;
+		vector<Vertex *> indexed_vertices; // Vertices numbered 0 .. n-1, in no particular order
 		bool is_directed;
+		bool copy_on_write; // Copies of the graph share the edges of the vertices until they are modified
+		
+		// Components over the vertex indices, updated by every insertion and deletion while the index is enabled
+		mutable DynamicConnectivity connectivity;
+		bool connectivity_enabled;
+		mutable bool connectivity_stale; // Set by the modifications the index cannot follow, it is rebuilt on the next query
+		
+		// Topological order over the vertex indices of a directed graph, kept through every insertion and deletion while enabled
+		mutable DynamicTopologicalOrder topological_order;
+		bool topological_order_enabled;
+		mutable bool topological_order_stale;
+		
+		// Interval labels over the strongly connected components, rebuilt on the first query after a modification
+		mutable ReachabilityIndex reachability;
+		bool reachability_enabled;
+		mutable bool reachability_stale;
+		unsigned int reachability_intervals;
 		
+		// Two hop labels for the exact hop distances, rebuilt on the first query after a modification
+		mutable HopLabelIndex hop_index;
+		bool hop_index_enabled;
+		mutable bool hop_index_stale;
+		
+		void refreshConnectivity() const;
+		bool refreshTopologicalOrder() const;
+		void refreshReachability() const;
+		void refreshHopIndex() const;
+		unsigned int strongComponents(vector<unsigned int> &component) const;
+		unsigned int countReachable(unsigned int start, bool backwards) const;
+		vector<T> labelPositions(vector<unsigned int> &position) const;
+		bool kahnOrder(vector<unsigned int> &ready) const;
+		template <class Sets>
+		vector<vector<T> > groupBySet(Sets &s) const;
+		
+		Vertex * newVertex(T label);
+		Vertex * newVertex(const Vertex &v, bool share, bool transpose);
+		void deleteVertex(Vertex *vtx);
 		Vertex * findVertex(T label) const;
+		void unindexVertex(Vertex *vtx);
+		void detachVertex(Vertex *vtx);
+		set<unsigned int> neighbourIndices(const Vertex *vtx) const;
+		Neighbours getAdjacentNodes(const Vertex *vtx) const;
+		Neighbours getReverseNodes(const Vertex *vtx) const;
+		
+		vector<FlatEdge> flatEdges() const;
+		bool findNonSimpleEdges(vector<T> *self_loops, vector<pair<T, T> > *parallel_edges) const;
+		bool findUndirectedCycle(vector<T> &cycle) const;
+		bool findDirectedCycle(vector<T> &cycle) const;
+		vector<FlatEdge> kruskalForest(unsigned int num_trees) const;
+		
+		static bool byEndpoints(const FlatEdge &e1, const FlatEdge &e2);
+		static void bucketEdges(const vector<FlatEdge> &edges, unsigned int n, bool by_dest, vector<unsigned int> &first, vector<FlatEdge> &res);
+		static void mergeParallelEdges(vector<FlatEdge> &edges, unsigned int n);
+		static void contractEdges(const vector<FlatEdge> &edges, unsigned int n, unsigned int t, vector<FlatEdge> &res, Xoshiro256 &rng);
+		static int kargerSteinCut(const vector<FlatEdge> &edges, unsigned int n, Xoshiro256 &rng);
 		
-		vector<Vertex *> findVerticesWithIndegreeZero() const;
 		void findFinishOrder(T label, stack<T> & finished_vertices, map<T, bool> & visited) const;
 		
 		bool addOneWayEdge(T head, T tail, int cost = 1);
+		
+		Graph(const Graph<T> &g, bool transpose);
 	
 	public:
-		Graph(bool is_directed);
+		// Walks the edges straight out of the adjacency of the vertices. It is a by value iterator: operator* builds the edge
+		// and operator-> hands out a proxy holding it. An undirected edge is seen once, from its endpoint with the smaller label
+		class EdgeIterator
+		{
+			private:
+				typename map<T, Vertex *>::const_iterator vertex, last;
+				typename Adjacency::const_iterator adj;
+				const vector<Vertex *> *indexed_vertices;
+				bool is_directed;
+				
+				// Moves on to the first edge to be listed, from the current position
+				void settle()
+				{
+					while(vertex != last)
+					{
+						if(adj == vertex->second->adjacency().end())
+						{
+							if(++vertex != last)
+							{
+								adj = vertex->second->adjacency().begin();
+							}
+						}
+						else if(is_directed || !((*indexed_vertices)[adj->first]->getLabel() < vertex->first))
+						{
+							return;
+						}
+						else
+						{
+							adj++;
+						}
+					}
+				}
+				
+			public:
+				// Keeps the edge alive for the member access through operator->
+				class ArrowProxy
+				{
+					private:
+						Edge<T> edge;
+						
+					public:
+						ArrowProxy(const Edge<T> &edge) : edge(edge)
+						{
+						}
+						
+						const Edge<T> * operator->() const
+						{
+							return &edge;
+						}
+				};
+				
+				typedef forward_iterator_tag iterator_category;
+				typedef Edge<T> value_type;
+				typedef ptrdiff_t difference_type;
+				typedef ArrowProxy pointer;
+				typedef Edge<T> reference;
+				
+				EdgeIterator(const map<T, Vertex *> &vertices, const vector<Vertex *> &indexed_vertices, bool is_directed, bool at_end)
+					: vertex(at_end? vertices.end(): vertices.begin()), last(vertices.end()), indexed_vertices(&indexed_vertices), is_directed(is_directed)
+				{
+					if(vertex != last)
+					{
+						adj = vertex->second->adjacency().begin();
+						settle();
+					}
+				}
+				
+				Edge<T> operator*() const
+				{
+					return Edge<T>(vertex->first, (*indexed_vertices)[adj->first]->getLabel(), adj->second);
+				}
+				
+				ArrowProxy operator->() const
+				{
+					return ArrowProxy(**this);
+				}
+				
+				EdgeIterator & operator++()
+				{
+					adj++;
+					settle();
+					
+					return *this;
+				}
+				
+				EdgeIterator operator++(int)
+				{
+					EdgeIterator old = *this;
+					
+					++(*this);
+					
+					return old;
+				}
+				
+				bool operator==(const EdgeIterator &itr) const
+				{
+					return vertex == itr.vertex && (vertex == last || adj == itr.adj);
+				}
+				
+				bool operator!=(const EdgeIterator &itr) const
+				{
+					return !(*this == itr);
+				}
+		};
+		
+		// The edges as a range for the loops and the algorithms of the standard library, valid until the graph is modified
+		class EdgeRange
+		{
+			private:
+				const map<T, Vertex *> &vertices;
+				const vector<Vertex *> &indexed_vertices;
+				bool is_directed;
+				
+			public:
+				EdgeRange(const map<T, Vertex *> &vertices, const vector<Vertex *> &indexed_vertices, bool is_directed)
+					: vertices(vertices), indexed_vertices(indexed_vertices), is_directed(is_directed)
+				{
+				}
+				
+				EdgeIterator begin() const
+				{
+					return EdgeIterator(vertices, indexed_vertices, is_directed, false);
+				}
+				
+				EdgeIterator end() const
+				{
+					return EdgeIterator(vertices, indexed_vertices, is_directed, true);
+				}
+		};
+		
+		Graph(bool is_directed, shared_ptr<NodePool> pool = shared_ptr<NodePool>());
 		Graph(const Graph<T> &g);
+		Graph(Graph<T> &&g) noexcept;
 		~Graph();
 
+		static Graph<T> fromEdges(const vector<Edge<T> > &edges, bool is_directed, bool deduplicate = false, bool drop_self_loops = false);
+		
 		Graph<T> reverse() const;
 		
 		bool addVertex(T label);
@@ -193,7 +505,9 @@ class Graph
 		
 		vector<int> edgeCosts(T head, T tail) const;
 		
-		void operator=(const Graph<T> &g);
+		Graph<T> & operator=(const Graph<T> &g);
+		Graph<T> & operator=(Graph<T> &&g) noexcept;
+		void swap(Graph<T> &g) noexcept;
 		
 		int indegree(T label) const;
 		int outdegree(T label) const;
@@ -202,15 +516,21 @@ class Graph
 		unsigned int numEdges() const;
 		
 		void removeSelfLoops();
+		unsigned int simplify();
 		
 		bool mergeVertices(T first, T second, T new_label);
 		
 		T pickRandomVertex() const;
 		Edge<T> * pickRandomEdge() const;
+		bool pickRandomEdge(Edge<T> &edge) const;
 		
-		int minCut() const;
+		int minCut(double success_probability = 0.999) const;
+		pair<int, pair<vector<T>, vector<T> > > stoerWagnerMinCut() const;
+		pair<long long, pair<vector<T>, vector<T> > > maxFlow(T source, T sink, MaxFlowAlgorithm algorithm = DINIC) const;
 		
 		vector<T> topologicalSort() const;
+		bool topologicalSort(vector<T> &order) const;
+		bool topologicalLevels(vector<vector<T> > &levels) const;
 		
 		vector<T> dfs() const;
 		vector<T> dfs(T start) const;
@@ -219,15 +539,24 @@ class Graph
 		vector<T> bfs(T start) const;
 		
 		map<T, unsigned int> hop_distance(T from) const;
+		int hop_distance(T from, T to) const;
 
 		pair<vector<T>, vector<vector<int> > > adjacencyMatrix() const;
+		pair<vector<T>, DenseMatrix<int> > flatAdjacencyMatrix() const;
+		vector<T> adjacencyMatrix(int *matrix) const;
 		pair<vector<T>, vector<vector<bool> > > connectivityList() const;
+		pair<vector<T>, BitMatrix> connectivityBits() const;
+		vector<T> connectivityList(uint64_t *bits) const;
+		pair<vector<T>, SparseMatrix<int> > sparseMatrix() const;
+		pair<vector<T>, BitMatrix> transitiveClosure(bool parallel = true) const;
 		
 		bool isDirected() const;
 		bool isWeighted() const;
 		bool isConnected() const;
 		bool isAcyclic() const;
+		bool isAcyclic(vector<T> &cycle) const;
 		bool isSimple() const;
+		bool isSimple(vector<T> &self_loops, vector<pair<T, T> > &parallel_edges) const;
 		
 		bool hasNegativeWeightedEdge() const;
 		
@@ -240,17 +569,45 @@ class Graph
 		pair<vector<T>, vector<vector<pair<T, int> > > > shortestPath() const;
 		
 		Graph<T> minimumSpanningTree() const;
+		Graph<T> kruskalMinimumSpanningTree() const;
+		vector<vector<T> > singleLinkageClusters(unsigned int k) const;
 		
 		void printPath(ostream &out, map<T, pair<T, int> > path) const;
 		void printPath(ostream &out, pair<vector<T>, vector<vector<pair<T, int> > > > dist) const;
 		
 		vector<T> getVertices() const;
 		vector<Edge<T> *> getEdges() const;
+		EdgeRange edges() const;
+		template <class Function>
+		void forEachEdge(Function fn) const;
+		void exportEdges(vector<Edge<T> > &res) const;
 		
 		vector<vector<T> > getVerticesComponentwise() const;
 		vector<Graph<T> *> getConnectedComponents() const;
 		
-		friend ostream &operator<<(ostream &out, Graph &g)
+		bool enableConnectivityIndex();
+		void disableConnectivityIndex();
+		bool connected(T first, T second) const;
+		T componentOf(T label) const;
+		unsigned int numComponents() const;
+		
+		bool enableTopologicalOrder();
+		void disableTopologicalOrder();
+		vector<T> topologicalOrder() const;
+		
+		void enableReachabilityIndex(unsigned int num_intervals = REACHABILITY_INTERVALS);
+		void disableReachabilityIndex();
+		
+		void enableHopIndex();
+		void disableHopIndex();
+		void saveHopIndex(ostream &out) const;
+		bool loadHopIndex(istream &in);
+		
+		void enableCopyOnWrite();
+		void disableCopyOnWrite();
+		unsigned int numSharedVertices() const;
+		
+		friend ostream &operator<<(ostream &out, const Graph &g)
 		{	
 			out << (g.isDirected()? "Directed, ": "Undirected, ");
 			out << (g.isWeighted()? "Weighted, ": "Unweighted, ");
@@ -259,21 +616,36 @@ class Graph
 			out << (g.isSimple()? "Simple ": "Non simple ");
 			out << "graph" << endl;			
 
-			for(typename map<T, Vertex *>::iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
+			for(typename map<T, Vertex *>::const_iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
 			{	
-				out << (*(v->second));
+				Neighbours adj = g.getAdjacentNodes(v->second);
+				
+				// The neighbours are printed in the order of their labels, the copies of an edge by their costs
+				stable_sort(adj.begin(), adj.end(), [](const pair<Vertex *, int> &a1, const pair<Vertex *, int> &a2)
+				{
+					return a1.first->getLabel() < a2.first->getLabel();
+				});
+				
+				out << v->first << " --->  ";
+				
+				for(typename Neighbours::const_iterator itr = adj.begin(); itr != adj.end(); itr++)
+				{
+					out << itr->first->getLabel() << "(" << itr->second << "), ";
+				}
+				
+				out << "\b\b " << endl;
 			}
 			
 			#ifdef DEBUG
-			for(typename map<T, Vertex *>::iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
+			for(typename map<T, Vertex *>::const_iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
 			{
-				multiset<Vertex *> nbh = v->second->getReverseNodes();
+				Neighbours nbh = g.getReverseNodes(v->second);
 					
 				out << v->second->getLabel() << "(" << nbh.size() << " nodes) --->  ";
 				
-				for(typename multiset<Vertex *>::iterator adj = nbh.begin(); adj != nbh.end(); adj++)
+				for(typename Neighbours::iterator adj = nbh.begin(); adj != nbh.end(); adj++)
 				{
-					out << (*adj)->getLabel() << ", ";
+					out << adj->first->getLabel() << "(" << adj->second << "), ";
 				}
 				
 				out << "\b\b " << endl;
@@ -286,89 +658,179 @@ class Graph
 };
 
 template <class T>
-Graph<T>::Vertex::Vertex(T label) : label(label)
+void swap(Graph<T> &g1, Graph<T> &g2) noexcept
 {
+	g1.swap(g2);
 }
 
+/**
+	The reverse of a graph, on which any of the algorithms of Graph<T> can be run against the direction of the edges.
+
+	The edges are shared with the graph and not copied, only a record per vertex is made. The view is a snapshot:
+	the graph may be modified afterwards, it then copies the edges of the vertices it modifies and the view keeps
+	the old ones.
+**/
 template <class T>
-Graph<T>::Vertex::~Vertex()
+class TransposedView
 {
-	vector<typename multiset<pair<Graph<T>::Vertex *, int> >::iterator> avec;
-	
-	for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator v = adj.begin(); v != adj.end(); v++)
+	private:
+		Graph<T> transposed;
+		
+	public:
+		TransposedView(const Graph<T> &g) : transposed(g.reverse())
+		{
+		}
+		
+		const Graph<T> & graph() const
+		{
+			return transposed;
+		}
+		
+		const Graph<T> & operator*() const
+		{
+			return transposed;
+		}
+		
+		const Graph<T> * operator->() const
+		{
+			return &transposed;
+		}
+};
+
+template <class T>
+Graph<T>::Vertex::Vertex(T label, NodePool *pool) : label(label), index(0), adj(newAdjacency(pool)), rev(newAdjacency(pool))
+{
+}
+
+// The edges of v are shared if share, copied into pool otherwise. With transpose, the incoming edges of v become the outgoing ones
+template <class T>
+Graph<T>::Vertex::Vertex(const Vertex &v, bool share, bool transpose, NodePool *pool) : label(v.label), index(v.index),
+	adj(transpose? v.rev: v.adj), rev(transpose? v.adj: v.rev)
+{
+	if(!share)
 	{
-		avec.push_back(v);
+		adj = SharedAdjacency(*adj, pool);
+		rev = SharedAdjacency(*rev, pool);
 	}
-	
-	// Remove outgoing edges
-	for(int i = avec.size() - 1; i >= 0; i--)
+}
+
+template <class T>
+void Graph<T>::Vertex::setLabel(T label)
+{
+	this->label = label;
+}
+
+template <class T>
+T Graph<T>::Vertex::getLabel() const
+{
+	return label;
+}
+
+template <class T>
+void Graph<T>::Vertex::setIndex(unsigned int index)
+{
+	this->index = index;
+}
+
+template <class T>
+unsigned int Graph<T>::Vertex::getIndex() const
+{
+	return index;
+}
+
+// The set and its count are both taken from the pool, in one block
+template <class T>
+typename Graph<T>::SharedAdjacency Graph<T>::Vertex::newAdjacency(NodePool *pool)
+{
+	return SharedAdjacency(Adjacency(less<pair<unsigned int, int> >(), PoolAllocator<pair<unsigned int, int> >(pool)));
+}
+
+// The set to be modified, copied first if some other copy of the graph uses it too
+template <class T>
+typename Graph<T>::Adjacency & Graph<T>::Vertex::own(SharedAdjacency &edges)
+{
+	if(!edges.unique())
 	{
-		this->removeEdge(avec[i]->first, avec[i]->second);
+		edges = SharedAdjacency(*edges);
 	}
 	
-	assert(adj.empty());
-	
-	vector<typename multiset<Graph<T>::Vertex *>::iterator> vec;
+	return *edges;
+}
+
+// Removes every entry of the vertex w from the set and returns their costs
+template <class T>
+vector<int> Graph<T>::Vertex::takeEntries(SharedAdjacency &edges, unsigned int w)
+{
+	vector<int> costs;
+	typename Adjacency::const_iterator itr = edges->lower_bound(make_pair(w, INT_MIN));
 	
-	for(typename multiset<Graph<T>::Vertex *>::iterator v = rev.begin(); v != rev.end(); v++)
+	if(itr == edges->end() || itr->first != w)
 	{
-		vec.push_back(v);
+		return costs;
 	}
 	
-	// Remove incoming edges
-	for(int i = vec.size() - 1; i >= 0; i--)
+	Adjacency &own_edges = own(edges);
+	typename Adjacency::iterator first = own_edges.lower_bound(make_pair(w, INT_MIN)), last = first;
+	
+	for(; last != own_edges.end() && last->first == w; last++)
 	{
-		(*vec[i])->removeEdge(this);
+		costs.push_back(last->second);
 	}
 	
-	assert(rev.empty());
+	own_edges.erase(first, last);
+	
+	return costs;
 }
 
 template <class T>
-void Graph<T>::Vertex::setLabel(T label)
+const typename Graph<T>::Adjacency & Graph<T>::Vertex::adjacency() const
 {
-	this->label = label;
+	return *adj;
 }
 
 template <class T>
-T Graph<T>::Vertex::getLabel() const
+const typename Graph<T>::Adjacency & Graph<T>::Vertex::reverseAdjacency() const
 {
-	return label;
+	return *rev;
 }
 
+// Whether the edges of the vertex are all still used by some other copy of the graph as well
 template <class T>
-multiset<pair<typename Graph<T>::Vertex *, int> > Graph<T>::Vertex::getAdjacentNodes() const
+bool Graph<T>::Vertex::sharesEdges() const
 {
-	return adj;
+	return !adj.unique() && !rev.unique();
 }
 
+// Copies of an edge are next to each other, in the order of their costs
 template <class T>
-multiset<typename Graph<T>::Vertex *> Graph<T>::Vertex::getReverseNodes() const
+typename Graph<T>::Adjacency::const_iterator Graph<T>::Vertex::findAdjacent(unsigned int dest) const
 {
-	return rev;
+	typename Adjacency::const_iterator itr = adj->lower_bound(make_pair(dest, INT_MIN));
+	
+	return (itr != adj->end() && itr->first == dest)? itr: adj->end();
 }
 
 template <class T>
-typename multiset<pair<typename Graph<T>::Vertex *, int> >::iterator Graph<T>::Vertex::findAdjacent(Graph<T>::Vertex *dest) const
+void Graph<T>::Vertex::addEdge(Graph<T>::Vertex *dest, int cost)
 {
-	for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator itr = adj.begin(); itr != adj.end(); itr++)
-	{
-		if(itr->first == dest)
-		{
-			return itr;
-		}
-	}
-		
-	return adj.end();
+	assert(dest != NULL);
+
+	own(adj).insert(make_pair(dest->index, cost));
+	own(dest->rev).insert(make_pair(index, cost));
 }
 
+// Only one end of the edge is recorded, the other is left to appendIncoming().
+// The insertion is in constant time if the edge does not come before any other in the adjacency
 template <class T>
-void Graph<T>::Vertex::addEdge(Graph<T>::Vertex *dest, int cost)
+void Graph<T>::Vertex::appendEdge(unsigned int dest, int cost)
 {
-	assert(dest != NULL);
+	own(adj).insert(adj->end(), make_pair(dest, cost));
+}
 
-	adj.insert(make_pair(dest, cost));
-	dest->rev.insert(this);
+template <class T>
+void Graph<T>::Vertex::appendIncoming(unsigned int src, int cost)
+{
+	own(rev).insert(rev->end(), make_pair(src, cost));
 }
 
 template <class T>
@@ -376,81 +838,158 @@ bool Graph<T>::Vertex::removeEdge(Graph<T>::Vertex *dest, int cost)
 {
 	assert(dest != NULL);
 	
-	typename multiset<pair<Graph<T>::Vertex *, int> >::iterator pos = adj.find(make_pair(dest, cost));
-	
-	if(pos == adj.end())
+	if(adj->find(make_pair(dest->index, cost)) == adj->end())
 	{
 		return false;
 	}
 	
-	this->adj.erase(pos); // This is done so that only one copy of the edge is deleted
-	dest->rev.erase(dest->rev.find(this));
+	Adjacency &out = own(adj);
+	Adjacency &in = own(dest->rev);
+	
+	out.erase(out.find(make_pair(dest->index, cost))); // This is done so that only one copy of the edge is deleted
+	in.erase(in.find(make_pair(index, cost)));
 	
 	return true;
 }
 
+// The cheapest copy of the edge is removed
 template <class T>
 bool Graph<T>::Vertex::removeEdge(Graph<T>::Vertex *dest)
 {
 	assert(dest != NULL);
 	
-	typename multiset<pair<Graph<T>::Vertex *, int> >::iterator pos = findAdjacent(dest);
-	
-	if(pos == adj.end())
-	{
-		return false;
-	}
-	
-	this->adj.erase(pos); // This is done so that only one copy of the edge is deleted
-	dest->rev.erase(dest->rev.find(this));
+	typename Adjacency::const_iterator pos = findAdjacent(dest->index);
 	
-	return true;
+	return (pos != adj->end()) && removeEdge(dest, pos->second);
 }
 
+// Removes every copy of the edge from this end only and returns their costs
 template <class T>
-void Graph<T>::Vertex::addEdgesInBatch(multiset<pair<Graph<T>::Vertex *, int> > new_adj)
+vector<int> Graph<T>::Vertex::removeEdgesTo(unsigned int dest)
 {
-	// adj.insert() is not used intentionally because, backword pointers are needed for deletion
-	for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator v = new_adj.begin(); v != new_adj.end(); v++)
-	{
-		addEdge(v->first, v->second);
-	}
+	return takeEntries(adj, dest);
 }
 
+// Removes the reverse entries of all the edges from src, from this end only
 template <class T>
-bool Graph<T>::Vertex::edgeExists(Graph<T>::Vertex *dest, int cost) const
+void Graph<T>::Vertex::removeIncoming(unsigned int src)
 {
-	assert(dest != NULL);
-	return adj.find(make_pair(dest, cost)) != adj.end();
+	takeEntries(rev, src);
 }
 
+// Removes the reverse entry of one copy of the edge from src, from this end only
 template <class T>
-bool Graph<T>::Vertex::edgeExists(Graph<T>::Vertex *dest) const
+void Graph<T>::Vertex::removeIncoming(unsigned int src, int cost)
 {
-	assert(dest != NULL);
-	return findAdjacent(dest) != adj.end();
+	if(rev->find(make_pair(src, cost)) != rev->end())
+	{
+		Adjacency &in = own(rev);
+		
+		in.erase(in.find(make_pair(src, cost)));
+	}
 }
 
+// Drops the edges of this vertex, without touching the other ends
 template <class T>
-unsigned int Graph<T>::Vertex::countEdge(Graph<T>::Vertex *dest, int cost) const
+void Graph<T>::Vertex::clearEdges()
 {
-	assert(dest != NULL);
-	return adj.count(make_pair(dest, cost));
+	adj = newAdjacency(adj->get_allocator().getPool());
+	rev = newAdjacency(rev->get_allocator().getPool());
 }
 
+// Removes the self loops and all but the cheapest copy of the parallel edges, the removed edges are appended to removed.
+// Their reverse entries are left to the caller
 template <class T>
-unsigned int Graph<T>::Vertex::countEdge(Graph<T>::Vertex *dest) const
+void Graph<T>::Vertex::simplify(vector<pair<unsigned int, int> > &removed)
 {
-	assert(dest != NULL);
-	
-	unsigned int count = 0;
+	const size_t old_size = removed.size();
+	unsigned int prev = UINT_MAX;
 	
-	for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator itr = adj.begin(); itr != adj.end(); itr++)
+	// Copies of an edge are next to each other in the adjacency, ordered by the cost
+	for(typename Adjacency::const_iterator itr = adj->begin(); itr != adj->end(); itr++)
 	{
-		if(itr->first == dest)
+		if(itr->first == index || itr->first == prev)
 		{
-			count++;
+			removed.push_back(*itr);
 		}
+		
+		prev = itr->first;
+	}
+	
+	if(removed.size() == old_size)
+	{
+		return;
+	}
+	
+	Adjacency &out = own(adj);
+	typename Adjacency::iterator itr = out.begin();
+	
+	prev = UINT_MAX;
+	
+	while(itr != out.end())
+	{
+		if(itr->first == index || itr->first == prev)
+		{
+			out.erase(itr++);
+		}
+		else
+		{
+			prev = itr->first;
+			itr++;
+		}
+	}
+}
+
+// The vertex numbered from is renumbered to, in the edges of this vertex
+template <class T>
+void Graph<T>::Vertex::renumberNeighbour(unsigned int from, unsigned int to)
+{
+	vector<int> costs = takeEntries(adj, from);
+	
+	for(unsigned int i = 0; i < costs.size(); i++)
+	{
+		own(adj).insert(make_pair(to, costs[i]));
+	}
+	
+	costs = takeEntries(rev, from);
+	
+	for(unsigned int i = 0; i < costs.size(); i++)
+	{
+		own(rev).insert(make_pair(to, costs[i]));
+	}
+}
+
+template <class T>
+bool Graph<T>::Vertex::edgeExists(Graph<T>::Vertex *dest, int cost) const
+{
+	assert(dest != NULL);
+	return adj->find(make_pair(dest->index, cost)) != adj->end();
+}
+
+template <class T>
+bool Graph<T>::Vertex::edgeExists(Graph<T>::Vertex *dest) const
+{
+	assert(dest != NULL);
+	return findAdjacent(dest->index) != adj->end();
+}
+
+template <class T>
+unsigned int Graph<T>::Vertex::countEdge(Graph<T>::Vertex *dest, int cost) const
+{
+	assert(dest != NULL);
+	return adj->count(make_pair(dest->index, cost));
+}
+
+template <class T>
+unsigned int Graph<T>::Vertex::countEdge(Graph<T>::Vertex *dest) const
+{
+	assert(dest != NULL);
+	
+	unsigned int count = 0;
+	
+	for(typename Adjacency::const_iterator itr = findAdjacent(dest->index); itr != adj->end() && itr->first == dest->index; itr++)
+	{
+		count++;
 	}
 		
 	return count;
@@ -461,9 +1000,9 @@ int Graph<T>::Vertex::edgeCost(Graph<T>::Vertex *dest) const
 {
 	assert(dest != NULL);
 	
-	typename multiset<pair<Graph<T>::Vertex *, int> >::iterator pos = findAdjacent(dest);
+	typename Adjacency::const_iterator pos = findAdjacent(dest->index);
 	
-	return (pos == adj.end()? (int) INFINITY: pos->second);
+	return (pos == adj->end()? (int) INFINITY: pos->second);
 }
 
 template <class T>
@@ -473,12 +1012,9 @@ vector<int> Graph<T>::Vertex::edgeCosts(Graph<T>::Vertex *dest) const
 	
 	vector<int> res;
 	
-	for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator itr = adj.begin(); itr != adj.end(); itr++)
+	for(typename Adjacency::const_iterator itr = findAdjacent(dest->index); itr != adj->end() && itr->first == dest->index; itr++)
 	{
-		if(itr->first == dest)
-		{
-			res.push_back(itr->second);
-		}
+		res.push_back(itr->second);
 	}
 	
 	return res;
@@ -487,19 +1023,19 @@ vector<int> Graph<T>::Vertex::edgeCosts(Graph<T>::Vertex *dest) const
 template <class T>
 int Graph<T>::Vertex::indegree() const
 {
-	return rev.size();
+	return rev->size();
 }
 
 template <class T>
 int Graph<T>::Vertex::outdegree() const
 {
-	return adj.size();
+	return adj->size();
 }
 
 template <class T>
 bool Graph<T>::Vertex::hasNegativeWeightedEdge() const
 {
-	for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator itr = adj.begin(); itr != adj.end(); itr++)
+	for(typename Adjacency::const_iterator itr = adj->begin(); itr != adj->end(); itr++)
 	{
 		if(itr->second < 0)
 		{
@@ -511,90 +1047,445 @@ bool Graph<T>::Vertex::hasNegativeWeightedEdge() const
 }
 
 template <class T>
-void Graph<T>::Vertex::addIncomingEdges(Graph<T>::Vertex *dest)
+Graph<T>::Graph(bool is_directed, shared_ptr<NodePool> pool) : pool(pool), is_directed(is_directed), copy_on_write(false), connectivity_enabled(false), connectivity_stale(true), topological_order_enabled(false), topological_order_stale(true), reachability_enabled(false), reachability_stale(true), reachability_intervals(REACHABILITY_INTERVALS), hop_index_enabled(false), hop_index_stale(true)
 {
-	assert(dest != NULL);
+}
+
+// Builds the graph of the endpoints of the edges in one go. The labels are interned by a sort, and every adjacency
+// is filled from a bucket of its edges sorted in the order of the set, so that each insertion is at the end.
+// With deduplicate, only the cheapest copy of the parallel edges is kept
+template <class T>
+Graph<T> Graph<T>::fromEdges(const vector<Edge<T> > &edges, bool is_directed, bool deduplicate, bool drop_self_loops)
+{
+	Graph<T> g(is_directed);
+	vector<T> labels;
+	
+	labels.reserve(2 * edges.size());
+	
+	for(typename vector<Edge<T> >::const_iterator e = edges.begin(); e != edges.end(); e++)
+	{
+		labels.push_back(e->src);
+		labels.push_back(e->dest);
+	}
+	
+	parallelSort(labels.begin(), labels.end());
+	labels.erase(unique(labels.begin(), labels.end()), labels.end());
+	
+	const unsigned int n = labels.size();
+	
+	g.indexed_vertices.resize(n);
+	
+	for(unsigned int i = 0; i < n; i++)
+	{
+		Vertex *v = g.newVertex(labels[i]);
+		
+		v->setIndex(i);
+		g.indexed_vertices[i] = v;
+		g.vertices.insert(g.vertices.end(), make_pair(labels[i], v));
+	}
+	
+	// An undirected edge is taken from its endpoint with the smaller index, so that its copies meet
+	vector<FlatEdge> flat(edges.size());
+	
+	parallelFor(0, edges.size(), [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t i = lo; i < hi; i++)
+		{
+			flat[i].src = lower_bound(labels.begin(), labels.end(), edges[i].src) - labels.begin();
+			flat[i].dest = lower_bound(labels.begin(), labels.end(), edges[i].dest) - labels.begin();
+			flat[i].cost = edges[i].cost;
+			
+			if(!is_directed && flat[i].src > flat[i].dest)
+			{
+				std::swap(flat[i].src, flat[i].dest);
+			}
+		}
+	});
+	
+	if(drop_self_loops)
+	{
+		flat.erase(remove_if(flat.begin(), flat.end(), [](const FlatEdge &e)
+		{
+			return e.src == e.dest;
+		}), flat.end());
+	}
+	
+	vector<unsigned int> first;
+	vector<FlatEdge> bucketed;
+	
+	if(deduplicate)
+	{
+		vector<unsigned char> keep(flat.size(), 1);
+		
+		bucketEdges(flat, n, false, first, bucketed);
+		
+		parallelFor(0, n, [&](size_t lo, size_t hi, unsigned int)
+		{
+			for(size_t v = lo; v < hi; v++)
+			{
+				// The cheapest copy comes first
+				sort(bucketed.begin() + first[v], bucketed.begin() + first[v + 1], [](const FlatEdge &e1, const FlatEdge &e2)
+				{
+					return (e1.dest < e2.dest) || ((e1.dest == e2.dest) && (e1.cost < e2.cost));
+				});
+				
+				for(unsigned int i = first[v] + 1; i < first[v + 1]; i++)
+				{
+					keep[i] = (bucketed[i].dest != bucketed[i - 1].dest);
+				}
+			}
+		});
+		
+		flat.clear();
+		
+		for(unsigned int i = 0; i < bucketed.size(); i++)
+		{
+			if(keep[i])
+			{
+				flat.push_back(bucketed[i]);
+			}
+		}
+	}
+	
+	// Both the directions of an undirected edge are stored, a self loop only once
+	if(!is_directed)
+	{
+		const unsigned int m = flat.size();
+		
+		for(unsigned int i = 0; i < m; i++)
+		{
+			if(flat[i].src != flat[i].dest)
+			{
+				FlatEdge e = flat[i];
+				
+				std::swap(e.src, e.dest);
+				flat.push_back(e);
+			}
+		}
+	}
+	
+	const vector<Vertex *> &vtx = g.indexed_vertices;
+	const size_t grain = max((size_t) PARALLEL_GRAIN * n / (flat.size() + 1), (size_t) 1);
+	
+	// Every vertex is filled by one thread only
+	bucketEdges(flat, n, false, first, bucketed);
+	
+	parallelFor(0, n, [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t v = lo; v < hi; v++)
+		{
+			sort(bucketed.begin() + first[v], bucketed.begin() + first[v + 1], [](const FlatEdge &e1, const FlatEdge &e2)
+			{
+				return make_pair(e1.dest, e1.cost) < make_pair(e2.dest, e2.cost);
+			});
+			
+			for(unsigned int i = first[v]; i < first[v + 1]; i++)
+			{
+				vtx[v]->appendEdge(bucketed[i].dest, bucketed[i].cost);
+			}
+		}
+	}, grain);
+	
+	bucketEdges(flat, n, true, first, bucketed);
+	
+	parallelFor(0, n, [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t v = lo; v < hi; v++)
+		{
+			sort(bucketed.begin() + first[v], bucketed.begin() + first[v + 1], [](const FlatEdge &e1, const FlatEdge &e2)
+			{
+				return make_pair(e1.src, e1.cost) < make_pair(e2.src, e2.cost);
+			});
+			
+			for(unsigned int i = first[v]; i < first[v + 1]; i++)
+			{
+				vtx[v]->appendIncoming(bucketed[i].src, bucketed[i].cost);
+			}
+		}
+	}, grain);
+	
+	return g;
+}
+
+// The vertices keep their indices, so the edges are taken over as they are and the indexes stay valid.
+// In copy on write mode the edges are shared with g, each vertex copies its own on the first modification, into the pool
+// of g which is shared too. Otherwise a pooled graph is copied into a new pool of its own
+template <class T>
+Graph<T>::Graph(const Graph<T> &g) : pool((g.pool && !g.copy_on_write)? make_shared<NodePool>(g.pool->chunkSize()): g.pool), indexed_vertices(g.indexed_vertices.size()), is_directed(g.is_directed), copy_on_write(g.copy_on_write), connectivity(g.connectivity), connectivity_enabled(g.connectivity_enabled), connectivity_stale(g.connectivity_stale), topological_order(g.topological_order), topological_order_enabled(g.topological_order_enabled), topological_order_stale(g.topological_order_stale), reachability(g.reachability), reachability_enabled(g.reachability_enabled), reachability_stale(g.reachability_stale), reachability_intervals(g.reachability_intervals), hop_index(g.hop_index), hop_index_enabled(g.hop_index_enabled), hop_index_stale(g.hop_index_stale)
+{
+	for(unsigned int i = 0; i < indexed_vertices.size(); i++)
+	{
+		indexed_vertices[i] = newVertex(*g.indexed_vertices[i], copy_on_write, false);
+	}
 	
-	for(typename multiset<Graph<T>::Vertex *>::iterator v = rev.begin(); v != rev.end(); v++)
+	for(typename map<T, Vertex *>::const_iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
 	{
-		typename multiset<pair<Graph<T>::Vertex *, int> >::iterator fd = (*v)->findAdjacent(this);
-		(*v)->addEdge(dest, fd->second);
+		vertices.insert(vertices.end(), make_pair(v->first, indexed_vertices[v->second->getIndex()]));
 	}
 }
 
+// The vertices of g with the edges reversed, the edges are always shared with g. None of the indexes is enabled
 template <class T>
-Graph<T>::Graph(bool is_directed) : is_directed(is_directed)
+Graph<T>::Graph(const Graph<T> &g, bool transpose) : pool(g.pool), indexed_vertices(g.indexed_vertices.size()), is_directed(g.is_directed), copy_on_write(g.copy_on_write), connectivity_enabled(false), connectivity_stale(true), topological_order_enabled(false), topological_order_stale(true), reachability_enabled(false), reachability_stale(true), reachability_intervals(g.reachability_intervals), hop_index_enabled(false), hop_index_stale(true)
 {
+	for(unsigned int i = 0; i < indexed_vertices.size(); i++)
+	{
+		indexed_vertices[i] = newVertex(*g.indexed_vertices[i], true, transpose);
+	}
+	
+	for(typename map<T, Vertex *>::const_iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
+	{
+		vertices.insert(vertices.end(), make_pair(v->first, indexed_vertices[v->second->getIndex()]));
+	}
 }
 
+// Takes over the vertices of g, which is left as an empty graph without any index
 template <class T>
-Graph<T>::Graph(const Graph<T> &g)
+Graph<T>::Graph(Graph<T> &&g) noexcept : is_directed(g.is_directed), copy_on_write(false), connectivity_enabled(false), connectivity_stale(true), topological_order_enabled(false), topological_order_stale(true), reachability_enabled(false), reachability_stale(true), reachability_intervals(REACHABILITY_INTERVALS), hop_index_enabled(false), hop_index_stale(true)
 {
-	operator=(g);
+	swap(g);
 }
 
+// When no other graph uses the pool, nothing in it outlives this graph and the whole of it is released at once with the pool,
+// instead of destroying the vertices and their edge sets one by one. Vertices too large for the pool come from the heap and
+// have to be freed anyway
 template <class T>
 Graph<T>::~Graph()
 {
-	for(typename map<T, Vertex *>::iterator v = vertices.begin(); v != vertices.end(); v++)
+	if(!(pool && pool.use_count() == 1 && is_trivially_destructible<T>::value && sizeof(Vertex) <= NODE_POOL_MAX_BLOCK))
 	{
-		delete v->second;
+		for(typename map<T, Vertex *>::iterator v = vertices.begin(); v != vertices.end(); v++)
+		{
+			deleteVertex(v->second);
+		}
 	}
 	
 	vertices.clear();
+	indexed_vertices.clear();
+}
+
+template <class T>
+Graph<T> & Graph<T>::operator=(const Graph<T> &g)
+{
+	Graph<T> copy(g);
+	
+	swap(copy);
+	
+	return *this;
 }
 
+// The vertices this graph had are released right away, not left behind in g
 template <class T>
-void Graph<T>::operator=(const Graph<T> &g)
+Graph<T> & Graph<T>::operator=(Graph<T> &&g) noexcept
 {
-	is_directed = g.is_directed;
+	Graph<T> taken(std::move(g));
+	
+	swap(taken);
+	
+	return *this;
+}
 
-	for(typename map<T, Vertex *>::const_iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
+template <class T>
+void Graph<T>::swap(Graph<T> &g) noexcept
+{
+	pool.swap(g.pool);
+	vertices.swap(g.vertices);
+	indexed_vertices.swap(g.indexed_vertices);
+	std::swap(is_directed, g.is_directed);
+	std::swap(copy_on_write, g.copy_on_write);
+	
+	std::swap(connectivity, g.connectivity);
+	std::swap(connectivity_enabled, g.connectivity_enabled);
+	std::swap(connectivity_stale, g.connectivity_stale);
+	std::swap(topological_order, g.topological_order);
+	std::swap(topological_order_enabled, g.topological_order_enabled);
+	std::swap(topological_order_stale, g.topological_order_stale);
+	std::swap(reachability, g.reachability);
+	std::swap(reachability_enabled, g.reachability_enabled);
+	std::swap(reachability_stale, g.reachability_stale);
+	std::swap(reachability_intervals, g.reachability_intervals);
+	std::swap(hop_index, g.hop_index);
+	std::swap(hop_index_enabled, g.hop_index_enabled);
+	std::swap(hop_index_stale, g.hop_index_stale);
+}
+
+// The incoming edges of every vertex are its outgoing edges in the reverse graph, so the edges are shared with this graph
+// and not copied. Each graph copies the edges of a vertex on its first modification, the other one is not affected
+template <class T>
+Graph<T> Graph<T>::reverse() const
+{
+	return Graph<T>(*this, true);
+}
+
+template <class T>
+typename Graph<T>::Vertex * Graph<T>::newVertex(T label)
+{
+	void *block = pool? pool->allocate(sizeof(Vertex)): ::operator new(sizeof(Vertex));
+	
+	return new(block) Vertex(label, pool.get());
+}
+
+// Edge sets which are not shared are copied into the pool of this graph
+template <class T>
+typename Graph<T>::Vertex * Graph<T>::newVertex(const Vertex &v, bool share, bool transpose)
+{
+	void *block = pool? pool->allocate(sizeof(Vertex)): ::operator new(sizeof(Vertex));
+	
+	return new(block) Vertex(v, share, transpose, pool.get());
+}
+
+template <class T>
+void Graph<T>::deleteVertex(Vertex *vtx)
+{
+	vtx->~Vertex();
+	
+	if(pool)
+	{
+		pool->deallocate(vtx, sizeof(Vertex));
+	}
+	else
 	{
-		addVertex(v->first);
+		::operator delete(vtx);
 	}
+}
+
+template <class T>
+typename Graph<T>::Vertex * Graph<T>::findVertex(T label) const
+{
+	typename map<T, Vertex *>::const_iterator vtx = vertices.find(label);
+	return ((vtx == vertices.end())? NULL: vtx->second);
+}
+
+// The vertex must have been detached from its neighbours already
+template <class T>
+void Graph<T>::unindexVertex(Graph<T>::Vertex *vtx)
+{
+	assert(vtx != NULL);
 	
-	for(typename map<T, Vertex *>::const_iterator v = g.vertices.begin(); v != g.vertices.end(); v++)
+	// The last vertex takes over the slot, so that the numbering stays dense
+	Vertex *last = indexed_vertices.back();
+	
+	if(last != vtx)
 	{
-		multiset<pair<Graph<T>::Vertex *, int> > adj = v->second->getAdjacentNodes();
+		const unsigned int from = last->getIndex(), to = vtx->getIndex();
+		set<unsigned int> neighbours = neighbourIndices(last);
+		
+		// The edges refer to the vertices by their indices, so the neighbours of last are told about the move
+		neighbours.insert(from);
 		
-		for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator a = adj.begin(); a != adj.end(); a++)
+		for(set<unsigned int>::const_iterator w = neighbours.begin(); w != neighbours.end(); w++)
 		{
-			// Graph<T>::addEdge() is intentionally not called, because it might cause problems in case of undirected graph
-			findVertex(v->first)->addEdge(findVertex(a->first->getLabel()), a->second);
+			indexed_vertices[*w]->renumberNeighbour(from, to);
 		}
+		
+		last->setIndex(to);
+		indexed_vertices[to] = last;
 	}
+	
+	indexed_vertices.pop_back();
 }
 
+// Removes the edges of the vertex from both its ends
 template <class T>
-Graph<T> Graph<T>::reverse() const
+void Graph<T>::detachVertex(Graph<T>::Vertex *vtx)
 {
-	Graph<T> g(is_directed);
+	assert(vtx != NULL);
+	
+	const unsigned int index = vtx->getIndex();
+	set<unsigned int> neighbours = neighbourIndices(vtx);
+	
+	neighbours.erase(index);
+	
+	for(set<unsigned int>::const_iterator w = neighbours.begin(); w != neighbours.end(); w++)
+	{
+		Vertex *u = indexed_vertices[*w];
+		
+		u->removeEdgesTo(index);
+		u->removeIncoming(index);
+	}
+	
+	vtx->clearEdges();
+}
 
-	for(typename map<T, Vertex *>::const_iterator v = vertices.begin(); v != vertices.end(); v++)
+// Both the ends of the incoming and the outgoing edges, once each
+template <class T>
+set<unsigned int> Graph<T>::neighbourIndices(const Graph<T>::Vertex *vtx) const
+{
+	set<unsigned int> res;
+	
+	for(typename Adjacency::const_iterator a = vtx->adjacency().begin(); a != vtx->adjacency().end(); a++)
 	{
-		g.addVertex(v->first);
+		res.insert(res.end(), a->first);
 	}
 	
-	for(typename map<T, Vertex *>::const_iterator v = vertices.begin(); v != vertices.end(); v++)
+	for(typename Adjacency::const_iterator r = vtx->reverseAdjacency().begin(); r != vtx->reverseAdjacency().end(); r++)
 	{
-		multiset<pair<Graph<T>::Vertex *, int> > adj = v->second->getAdjacentNodes(); // Unfortunately rev cannot be used because it does not contain weight information
-		
-		for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
-		{
-			// Graph<T>::addEdge() is intentionally not called, because it might cause problems in case of undirected graph
-			g.findVertex(a->first->getLabel())->addEdge(g.findVertex(v->first), a->second);
-		}
+		res.insert(r->first);
 	}
 	
-	return g;
+	return res;
 }
 
+// In the order of the indices, so the copies of an edge are next to each other
 template <class T>
-typename Graph<T>::Vertex * Graph<T>::findVertex(T label) const
+typename Graph<T>::Neighbours Graph<T>::getAdjacentNodes(const Graph<T>::Vertex *vtx) const
 {
-	typename map<T, Vertex *>::const_iterator vtx = vertices.find(label);
-	return ((vtx == vertices.end())? NULL: vtx->second);
+	Neighbours res;
+	
+	res.reserve(vtx->adjacency().size());
+	
+	for(typename Adjacency::const_iterator a = vtx->adjacency().begin(); a != vtx->adjacency().end(); a++)
+	{
+		res.push_back(make_pair(indexed_vertices[a->first], a->second));
+	}
+	
+	return res;
+}
+
+// The sources of the incoming edges, with the costs of the edges
+template <class T>
+typename Graph<T>::Neighbours Graph<T>::getReverseNodes(const Graph<T>::Vertex *vtx) const
+{
+	Neighbours res;
+	
+	res.reserve(vtx->reverseAdjacency().size());
+	
+	for(typename Adjacency::const_iterator r = vtx->reverseAdjacency().begin(); r != vtx->reverseAdjacency().end(); r++)
+	{
+		res.push_back(make_pair(indexed_vertices[r->first], r->second));
+	}
+	
+	return res;
+}
+
+template <class T>
+vector<typename Graph<T>::FlatEdge> Graph<T>::flatEdges() const
+{
+	vector<FlatEdge> res;
+	
+	res.reserve(numEdges());
+	
+	for(unsigned int i = 0; i < indexed_vertices.size(); i++)
+	{
+		const Adjacency &adj = indexed_vertices[i]->adjacency();
+		
+		for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			FlatEdge e;
+			
+			e.src = i;
+			e.dest = a->first;
+			e.cost = a->second;
+			
+			// Undirected edges are stored in both the endpoints, but are listed only once
+			if(is_directed || e.src <= e.dest)
+			{
+				res.push_back(e);
+			}
+		}
+	}
+	
+	return res;
 }
 
 template <class T>
@@ -603,11 +1494,11 @@ void Graph<T>::findFinishOrder(T label, stack<T> & finished_vertices, map<T, boo
 	Vertex *vertex = findVertex(label);
 	assert(vertex != NULL);
 	
-	multiset<pair<Vertex *, int> > adj = vertex->getAdjacentNodes();
+	Neighbours adj = getAdjacentNodes(vertex);
 	
 	visited[label] = true;
 	
-	for(typename multiset<pair<Vertex *, int> >::iterator itr = adj.begin(); itr != adj.end(); itr++)
+	for(typename Neighbours::const_iterator itr = adj.begin(); itr != adj.end(); itr++)
 	{
 		if(!visited[itr->first->getLabel()])
 		{
@@ -669,23 +1560,7 @@ unsigned int Graph<T>::numEdges() const
 }
 
 template <class T>
-vector<typename Graph<T>::Vertex *> Graph<T>::findVerticesWithIndegreeZero() const
-{
-	vector<typename Graph<T>::Vertex *> res;
-	
-	for(typename map<T, typename Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-	{
-		if(itr->second->indegree() == 0)
-		{
-			res.push_back(itr->second);
-		}
-	}
-	
-	return res;
-}
-
-template <class T>
-bool Graph<T>::addVertex(T label)
+bool Graph<T>::addVertex(T label)
 {
 	// Node with same name already exists
 	if(findVertex(label) != NULL)
@@ -693,11 +1568,26 @@ bool Graph<T>::addVertex(T label)
 		return false;
 	}
 	
-	Vertex *new_node = new Vertex(label);
+	Vertex *new_node = newVertex(label);
 	// Memory full
 	assert(new_node != NULL);
 	
 	vertices[label] = new_node;
+	new_node->setIndex(indexed_vertices.size());
+	indexed_vertices.push_back(new_node);
+	
+	if(connectivity_enabled && !connectivity_stale)
+	{
+		connectivity.add();
+	}
+	
+	if(topological_order_enabled && !topological_order_stale)
+	{
+		topological_order.add();
+	}
+	
+	reachability_stale = true;
+	hop_index_stale = true;
 
 	return true;
 }
@@ -713,7 +1603,22 @@ bool Graph<T>::removeVertex(T label)
 		return false;
 	}
 
-	delete node;
+	if(connectivity_enabled && !connectivity_stale)
+	{
+		connectivity.remove(node->getIndex());	// Renumbers the same way as unindexVertex()
+	}
+	
+	if(topological_order_enabled && !topological_order_stale)
+	{
+		topological_order.remove(node->getIndex());	// Renumbers the same way as unindexVertex()
+	}
+	
+	reachability_stale = true;
+	hop_index_stale = true;
+	
+	detachVertex(node);
+	unindexVertex(node);
+	deleteVertex(node);
 	vertices.erase(label);
 	
 	return true;
@@ -753,7 +1658,18 @@ bool Graph<T>::addEdge(T head, T tail, int cost)
 		return false;
 	}
 	
+	// Edges closing a cycle are refused while the topological order is kept
+	if(is_directed && topological_order_enabled && refreshTopologicalOrder())
+	{
+		if(!topological_order.insertEdge(hd->getIndex(), tl->getIndex()))
+		{
+			return false;
+		}
+	}
+	
 	hd->addEdge(tl, cost);
+	reachability_stale = true;
+	hop_index_stale = true;
 	
 	if(!is_directed)
 	{
@@ -761,6 +1677,11 @@ bool Graph<T>::addEdge(T head, T tail, int cost)
 		{
 			tl->addEdge(hd, cost);
 		}
+		
+		if(connectivity_enabled && !connectivity_stale)
+		{
+			connectivity.insertEdge(hd->getIndex(), tl->getIndex());
+		}
 	}
 	
 	return true;
@@ -781,6 +1702,13 @@ bool Graph<T>::removeEdge(T head, T tail, int cost)
 	bool forward = true, backword = true;
 	
 	forward = hd->removeEdge(tl, cost);
+	reachability_stale = true;
+	hop_index_stale = true;
+	
+	if(forward && is_directed && topological_order_enabled && !topological_order_stale)
+	{
+		topological_order.deleteEdge(hd->getIndex(), tl->getIndex());
+	}
 	
 	if(!is_directed)
 	{
@@ -788,6 +1716,11 @@ bool Graph<T>::removeEdge(T head, T tail, int cost)
 		{
 			backword = tl->removeEdge(hd, cost);
 		}
+		
+		if(forward && connectivity_enabled && !connectivity_stale)
+		{
+			connectivity.deleteEdge(hd->getIndex(), tl->getIndex());
+		}
 	}
 	
 	return (forward && backword);
@@ -881,6 +1814,12 @@ bool Graph<T>::pathExists(T start, T end) const
 		return false;
 	}
 	
+	if(reachability_enabled)
+	{
+		refreshReachability();
+		return reachability.reachable(st->getIndex(), ed->getIndex());
+	}
+	
 	vector<T> intermediate = dfs(start);
 	
 	return find(intermediate.begin(), intermediate.end(), end) != intermediate.end();
@@ -898,6 +1837,48 @@ void Graph<T>::removeSelfLoops()
 	}
 }
 
+template <class T>
+unsigned int Graph<T>::simplify()
+{
+	unsigned int count = 0;
+	vector<pair<unsigned int, int> > removed;
+	
+	for(unsigned int i = 0; i < indexed_vertices.size(); i++)
+	{
+		removed.clear();
+		indexed_vertices[i]->simplify(removed);
+		
+		for(unsigned int j = 0; j < removed.size(); j++)
+		{
+			unsigned int w = removed[j].first;
+			
+			indexed_vertices[w]->removeIncoming(i, removed[j].second);
+			
+			// Undirected edges are removed from both the endpoints, but counted once
+			if(is_directed || w == i)
+			{
+				count++;
+				
+				if(is_directed && topological_order_enabled && !topological_order_stale)
+				{
+					topological_order.deleteEdge(i, w);
+				}
+			}
+			else if(i < w)
+			{
+				count++;
+				
+				if(connectivity_enabled && !connectivity_stale)
+				{
+					connectivity.deleteEdge(i, w);
+				}
+			}
+		}
+	}
+	
+	return count;
+}
+
 template <class T>
 vector<T> Graph<T>::topologicalSort() const
 {
@@ -906,54 +1887,153 @@ vector<T> Graph<T>::topologicalSort() const
 		throw strdup(NOT_A_DIRECTED_GRAPH);
 	}
 	
-	vector<Vertex *> l = findVerticesWithIndegreeZero();
+	vector<T> res;
 	
-	if(l.size() == 0)
+	if(!topologicalSort(res))
 	{
 		throw strdup(NOT_AN_ACYCLIC_GRAPH);
-	}	
+	}
 	
-	queue<Vertex *> q;
-	vector<T> res;
-	const unsigned int sz = vertices.size();
+	return res;
+}
+
+// Returns false, with a partial order, if the graph is undirected or has a cycle
+template <class T>
+bool Graph<T>::topologicalSort(vector<T> &order) const
+{
+	vector<unsigned int> ready;
 	
-	// Create and initialize table
-	map<T, unsigned int> indegree_table;
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	order.clear();
+	
+	if(!is_directed)
+	{
+		return false;
+	}
+	
+	bool acyclic = kahnOrder(ready);
+	
+	order.reserve(ready.size());
+	
+	for(unsigned int i = 0; i < ready.size(); i++)
 	{
-		indegree_table[itr->first] = itr->second->indegree();
+		order.push_back(indexed_vertices[ready[i]]->getLabel());
 	}
 	
-	for(int i = l.size() - 1; i >= 0; i--)
+	return acyclic;
+}
+
+// Kahn's algorithm on dense in-degree counts, the ready list doubles as the queue
+template <class T>
+bool Graph<T>::kahnOrder(vector<unsigned int> &ready) const
+{
+	const unsigned int n = indexed_vertices.size();
+	vector<unsigned int> indegree(n);
+	
+	ready.clear();
+	ready.reserve(n);
+	
+	for(unsigned int i = 0; i < n; i++)
 	{
-		q.push(l[i]);
+		indegree[i] = indexed_vertices[i]->indegree();
 	}
 	
-	while(res.size() < sz)
+	// Sources are taken in the descending order of their labels
+	for(typename map<T, Vertex *>::const_reverse_iterator itr = vertices.rbegin(); itr != vertices.rend(); itr++)
 	{
-		if(q.empty())
+		if(indegree[itr->second->getIndex()] == 0)
 		{
-			throw strdup(NOT_AN_ACYCLIC_GRAPH);
+			ready.push_back(itr->second->getIndex());
 		}
+	}
+	
+	for(unsigned int head = 0; head < ready.size(); head++)
+	{
+		const Adjacency &adj = indexed_vertices[ready[head]]->adjacency();
 		
-		Vertex *ft = q.front();
-		q.pop();
+		for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			if(--indegree[a->first] == 0)
+			{
+				ready.push_back(a->first);
+			}
+		}
+	}
+	
+	return ready.size() == n;
+}
+
+// levels[i] holds the vertices whose longest path from a source has i edges, so every level can be processed concurrently.
+// A level is built from the previous one by all the workers together, with atomic in-degree counts.
+// Returns false, with the levels found so far, if the graph is undirected or has a cycle
+template <class T>
+bool Graph<T>::topologicalLevels(vector<vector<T> > &levels) const
+{
+	levels.clear();
+	
+	if(!is_directed)
+	{
+		return false;
+	}
+	
+	const unsigned int n = indexed_vertices.size();
+	vector<atomic<unsigned int> > indegree(n);
+	vector<unsigned int> frontier;
+	unsigned int done = 0;
+	
+	for(unsigned int i = 0; i < n; i++)
+	{
+		indegree[i].store(indexed_vertices[i]->indegree(), memory_order_relaxed);
 		
-		res.push_back(ft->getLabel());
+		if(indexed_vertices[i]->indegree() == 0)
+		{
+			frontier.push_back(i);
+		}
+	}
+	
+	while(!frontier.empty())
+	{
+		// Every worker collects the vertices whose last incoming edge it removed
+		vector<vector<unsigned int> > found(numWorkers(frontier.size()));
 		
-		multiset<pair<Graph<T>::Vertex *, int> > adj = ft->getAdjacentNodes();
-		for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+		parallelFor(0, frontier.size(), [&](size_t lo, size_t hi, unsigned int worker)
 		{
-			indegree_table[a->first->getLabel()]--;
-			
-			if(indegree_table[a->first->getLabel()] == 0)
+			for(size_t i = lo; i < hi; i++)
 			{
-				q.push(a->first);
+				const Adjacency &adj = indexed_vertices[frontier[i]]->adjacency();
+				
+				for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+				{
+					unsigned int w = a->first;
+					
+					if(indegree[w].fetch_sub(1, memory_order_relaxed) == 1)
+					{
+						found[worker].push_back(w);
+					}
+				}
 			}
+		});
+		
+		levels.push_back(vector<T>());
+		levels.back().reserve(frontier.size());
+		
+		for(unsigned int i = 0; i < frontier.size(); i++)
+		{
+			levels.back().push_back(indexed_vertices[frontier[i]]->getLabel());
+		}
+		
+		done += frontier.size();
+		frontier.clear();
+		
+		for(unsigned int w = 0; w < found.size(); w++)
+		{
+			frontier.insert(frontier.end(), found[w].begin(), found[w].end());
 		}
+		
+		// The order within a level would otherwise depend on the thread timing
+		sort(frontier.begin(), frontier.end());
 	}
 	
-	return res;
+	return done == n;
 }
 
 template <class T>
@@ -1001,8 +2081,8 @@ vector<T> Graph<T>::dfs(T start) const
 			res.push_back(vtx->getLabel());
 			visited[vtx->getLabel()] = true;
 	
-			multiset<pair<Graph<T>::Vertex *, int> > adj = vtx->getAdjacentNodes();
-			for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+			Neighbours adj = getAdjacentNodes(vtx);
+			for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
 			{
 				stk.push(a->first);
 			}
@@ -1057,8 +2137,8 @@ vector<T> Graph<T>::bfs(T start) const
 			res.push_back(vtx->getLabel());
 			visited[vtx->getLabel()] = true;
 	
-			multiset<pair<Graph<T>::Vertex *, int> > adj = vtx->getAdjacentNodes();
-			for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+			Neighbours adj = getAdjacentNodes(vtx);
+			for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
 			{
 				q.push(a->first);
 			}
@@ -1100,8 +2180,8 @@ map<T, unsigned int> Graph<T>::hop_distance(T from) const
 			res[pr.first->getLabel()] = pr.second;
 			visited[pr.first->getLabel()] = true;
 	
-			multiset<pair<Graph<T>::Vertex *, int> > adj = pr.first->getAdjacentNodes();
-			for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+			Neighbours adj = getAdjacentNodes(pr.first);
+			for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
 			{
 				q.push(make_pair(a->first, pr.second + 1));
 			}
@@ -1111,982 +2191,2568 @@ map<T, unsigned int> Graph<T>::hop_distance(T from) const
 	return res;
 }
 
+// Hops on a shortest path from one vertex to the other, -1 if there is no such path
 template <class T>
-pair<vector<T>, vector<vector<int> > > Graph<T>::adjacencyMatrix() const
+int Graph<T>::hop_distance(T from, T to) const
 {
-	vector<T> v;
-	vector<vector<int> > res;
+	Vertex *src = findVertex(from);
+	Vertex *dest = findVertex(to);
 	
-	if(isSimple())
+	if((src == NULL) || (dest == NULL))
 	{
-		for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-		{
-			v.push_back(itr->first);
-		}
+		return -1;
+	}
+	
+	if(hop_index_enabled)
+	{
+		refreshHopIndex();
+		
+		unsigned int hops = hop_index.distance(src->getIndex(), dest->getIndex());
+		
+		return (hops == UINT_MAX)? -1: (int) hops;
+	}
+	
+	// Breadth first search which stops at the destination
+	vector<unsigned int> hops(indexed_vertices.size(), UINT_MAX);
+	vector<unsigned int> q(1, src->getIndex());
 	
-		for(typename vector<T>::const_iterator i = v.begin(); i != v.end(); i++)
+	hops[src->getIndex()] = 0;
+	
+	for(unsigned int head = 0; head < q.size(); head++)
+	{
+		unsigned int v = q[head];
+		
+		if(v == dest->getIndex())
 		{
-			vector<int> l;
+			return hops[v];
+		}
 		
-			for(typename vector<T>::const_iterator j = v.begin(); j != v.end(); j++)
+		const Adjacency &adj = indexed_vertices[v]->adjacency();
+		
+		for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			if(hops[a->first] == UINT_MAX)
 			{
-				if(*i == *j)
-				{
-					l.push_back(0);
-				}
-				else
-				{
-					l.push_back(findVertex(*i)->edgeCost(findVertex(*j)));
-				}
+				hops[a->first] = hops[v] + 1;
+				q.push_back(a->first);
 			}
-		
-			res.push_back(l);
 		}
 	}
-		
-	return make_pair(v, res);
+	
+	return -1;
 }
 
 template <class T>
-pair<vector<T>, vector<vector<bool> > > Graph<T>::connectivityList() const
+void Graph<T>::refreshHopIndex() const
 {
-	vector<T> v;
-	vector<vector<bool> > res;
-	
-	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	if(!hop_index_stale)
 	{
-		v.push_back(itr->first);
+		return;
 	}
-
-	for(typename vector<T>::const_iterator i = v.begin(); i != v.end(); i++)
+	
+	vector<FlatEdge> edges = flatEdges();
+	vector<pair<unsigned int, unsigned int> > arcs;
+	
+	arcs.reserve(is_directed? edges.size(): 2 * edges.size());
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
 	{
-		vector<bool> l;
-
-		for(typename vector<T>::const_iterator j = v.begin(); j != v.end(); j++)
+		arcs.push_back(make_pair(e->src, e->dest));
+		
+		if(!is_directed)
 		{
-			l.push_back((*i == *j) || edgeExists(*i, *j));
+			arcs.push_back(make_pair(e->dest, e->src));
 		}
-	
-		res.push_back(l);
 	}
-
-	return make_pair(v, res);
+	
+	hop_index.build(indexed_vertices.size(), arcs, is_directed);
+	hop_index_stale = false;
 }
 
+// From now on, hop_distance(from, to) answers from the labels. Once they are built, that is after
+// the first query following a modification, any number of threads can query them together
 template <class T>
-bool Graph<T>::isDirected() const
+void Graph<T>::enableHopIndex()
 {
-	return is_directed;
+	if(!hop_index_enabled)
+	{
+		hop_index_enabled = true;
+		hop_index_stale = true;
+	}
 }
 
 template <class T>
-bool Graph<T>::isWeighted() const
+void Graph<T>::disableHopIndex()
 {
-	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-	{
-		multiset<pair<Graph<T>::Vertex *, int> > adj = itr->second->getAdjacentNodes();
-		for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
-		{
-			if(a->second != 1)
-			{	
-				return true;
-			}
-		}
-	}
-	
-	return false;
+	hop_index_enabled = false;
+	hop_index_stale = true;
+	hop_index = HopLabelIndex();
 }
 
+// The vertices are written out by their labels, so that the index can be loaded into any graph with the same vertices
 template <class T>
-bool Graph<T>::isConnected() const
+void Graph<T>::saveHopIndex(ostream &out) const
 {
-	if(numVertices() <= 1)
-	{
-		return true;
-	}
+	refreshHopIndex();
 	
-	if(is_directed)
+	out << indexed_vertices.size() << endl;
+	
+	for(unsigned int i = 0; i < indexed_vertices.size(); i++)
 	{
-		pair<vector<T>, vector<vector<bool> > > pr = connectivityList();
-		vector<vector<bool> > curr_matrix = pr.second;
-		vector<vector<bool> > prev_matrix;
-		const unsigned int n = numVertices();
-		
-		for(int k = 0; k < n; k++)
-		{
-			prev_matrix = curr_matrix;
-			
-			for(int i = 0; i < n; i++)
-			{
-				for(int j = 0; j < n; j++)
-				{
-					curr_matrix[i][j] = prev_matrix[i][j] || (prev_matrix[i][k] && prev_matrix[k][j]);
-				}
-			}
-		}
-		
-		for(int i = 0; i < n; i++)
-		{
-			for(int j = 0; j < n; j++)
-			{
-				if(!curr_matrix[i][j])
-				{
-					return false;
-				}
-			}
-		}
-		
-		return true;
+		out << indexed_vertices[i]->getLabel() << endl;
 	}
-		
-	// Undirected graph
-	T src = vertices.begin()->first;
-	vector<T> traversed = dfs(src);
 	
-	return traversed.size() == vertices.size();
+	hop_index.save(out);
 }
 
+// The index is taken as it is, it must have been saved from a graph with the same edges.
+// Returns false, leaving the index disabled, if the input is malformed or names other vertices
 template <class T>
-bool Graph<T>::isAcyclic() const
+bool Graph<T>::loadHopIndex(istream &in)
 {
-	if(numVertices() == 0)
+	unsigned int n;
+	
+	disableHopIndex();
+	
+	if(!(in >> n) || n != indexed_vertices.size())
 	{
-		return true;
+		return false;
 	}
 	
-	if(is_directed)
+	vector<unsigned int> position(n);
+	vector<bool> taken(n, false);
+	
+	for(unsigned int i = 0; i < n; i++)
 	{
-		// TODO: This is not the right way of detecting cycle in directed graph
-		try
-		{
-			topologicalSort();
-		}
-		catch(char *e)
+		T label;
+		Vertex *vtx;
+		
+		if(!(in >> label) || (vtx = findVertex(label)) == NULL || taken[vtx->getIndex()])
 		{
-			if(strcmp(e, NOT_AN_ACYCLIC_GRAPH) == 0)
-			{
-				return false;
-			}
+			return false;
 		}
 		
-		return true;
+		position[i] = vtx->getIndex();
+		taken[position[i]] = true;
 	}
 	
-	// Undirected graph
-	if(numEdges() > numVertices() - 1)
+	// Labels of the other kind of graph would load fine and answer wrong
+	if(!hop_index.load(in, position) || hop_index.isDirected() != is_directed)
 	{
+		hop_index = HopLabelIndex();
 		return false;
 	}
 	
-	Graph<T> g = *this;
-	DisjointSet<T> s;
-	
-	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = g.vertices.begin(); itr != g.vertices.end(); itr++)
-	{
-		s.create(itr->first);
-	}
-	
-	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = g.vertices.begin(); itr != g.vertices.end(); itr++)
-	{
-		multiset<pair<Graph<T>::Vertex *, int> > adj = itr->second->getAdjacentNodes();
-		
-		for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator it = adj.begin(); it != adj.end(); it++)
-		{
-			if(s.connected(itr->second->getLabel(), it->first->getLabel()))
-			{
-				return false;
-			}
-			
-			s.join(itr->second->getLabel(), it->first->getLabel());
-			itr->second->removeEdge(it->first);
-			it->first->removeEdge(itr->second);
-		}
-	}
+	hop_index_enabled = true;
+	hop_index_stale = false;
 	
 	return true;
 }
 
+// Copies made from now on share the edges of every vertex with this graph, and the copies of the copies too.
+// Either graph copies the edges of a vertex on its first modification that touches them, the other keeps the old ones.
+// Worth it when the copies are modified in a few places only, like the snapshots of a graph being updated.
+// Copies sharing edges may be modified on different threads, as long as each one is used by one thread at a time
 template <class T>
-bool Graph<T>::isSimple() const
+void Graph<T>::enableCopyOnWrite()
 {
-	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	copy_on_write = true;
+}
+
+// Copies made from now on get their own edges, the edges already shared stay shared until they are modified
+template <class T>
+void Graph<T>::disableCopyOnWrite()
+{
+	copy_on_write = false;
+}
+
+// Vertices whose edges are all still shared with some other copy of the graph
+template <class T>
+unsigned int Graph<T>::numSharedVertices() const
+{
+	unsigned int count = 0;
+	
+	for(unsigned int i = 0; i < indexed_vertices.size(); i++)
 	{
-		if(edgeExists(itr->first, itr->first))	// Self loops
-		{
-			return false;
-		}
-		
-		for(typename map<T, Graph<T>::Vertex *>::const_iterator it = vertices.begin(); it != vertices.end(); it++)
+		if(indexed_vertices[i]->sharesEdges())
 		{
-			if(countEdge(itr->first, it->first) > 1)
-			{
-				return false;
-			}
+			count++;
 		}
 	}
 	
-	return true;
+	return count;
 }
 
+// Sorted labels, with position[i] the place of the label of the vertex with index i
 template <class T>
-bool Graph<T>::hasNegativeWeightedEdge() const
+vector<T> Graph<T>::labelPositions(vector<unsigned int> &position) const
 {
-	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	vector<T> labels;
+	
+	labels.reserve(vertices.size());
+	position.resize(indexed_vertices.size());
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
 	{
-		if(itr->second->hasNegativeWeightedEdge())
-		{
-			return true;
-		}
+		position[itr->second->getIndex()] = labels.size();
+		labels.push_back(itr->first);
 	}
 	
-	return false;
+	return labels;
 }
 
 template <class T>
-map<T, pair<T, int> > Graph<T>::bfsShortestPath(T source) const
+pair<vector<T>, vector<vector<int> > > Graph<T>::adjacencyMatrix() const
 {
-	map<T, pair<T, int> > res;
+	pair<vector<T>, DenseMatrix<int> > pr = flatAdjacencyMatrix();
+	const unsigned int n = pr.first.size();
+	vector<vector<int> > res(n);
 	
-	if(!isDirected() && !isWeighted())
+	for(unsigned int i = 0; i < n; i++)
 	{
-		Vertex *vtx = findVertex(source);
-
-		if(vtx != NULL)
-		{
-			// Create and initialize table
-			map<T, bool> visited;
-			for(typename map<T, typename Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-			{
-				visited[itr->first] = false;
-			}
-	
-			queue<pair<Vertex *, pair<T, int> > > q;
-	
-			q.push(make_pair(vtx, make_pair(source, 0)));
+		res[i].assign(pr.second.data() + (size_t) i * n, pr.second.data() + (size_t) (i + 1) * n);
+	}
 	
-			while(!q.empty())
-			{
-				pair<Vertex *, pair<T, int> > pr = q.front();
-				q.pop();
-		
-				if(!visited[pr.first->getLabel()])
-				{
-					res[pr.first->getLabel()] = pr.second;
-					visited[pr.first->getLabel()] = true;
+	return make_pair(pr.first, res);
+}
+
+template <class T>
+pair<vector<T>, DenseMatrix<int> > Graph<T>::flatAdjacencyMatrix() const
+{
+	pair<vector<T>, DenseMatrix<int> > res;
 	
-					multiset<pair<Graph<T>::Vertex *, int> > adj = pr.first->getAdjacentNodes();
-					for(typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
-					{
-						q.push(make_pair(a->first, make_pair(pr.first->getLabel(), pr.second.second + 1)));
-					}
-				}
-			}
-			
-			for(typename map<T, bool>::const_iterator itr = visited.begin(); itr != visited.end(); itr++)
-			{
-				if(!itr->second)
-				{
-					res[itr->first] = make_pair(itr->first, (int) INFINITY);
-				}
-			}
-		}	
+	if(isSimple())
+	{
+		res.second.reset(numVertices(), numVertices());
+		res.first = adjacencyMatrix(res.second.data());
 	}
 	
 	return res;
 }
 
+// Writes the matrix in row major order to numVertices() * numVertices() ints of the caller, rows and columns in the order of the labels.
+// Only simple graphs have one, for the others nothing is written and no labels are returned
 template <class T>
-map<T, pair<T, int> > Graph<T>::topologicalShortestPath(T source) const
+vector<T> Graph<T>::adjacencyMatrix(int *matrix) const
 {
-	map<T, pair<T, int> > res;
+	if(!isSimple())
+	{
+		return vector<T>();
+	}
 	
-	if(isDirected() && isAcyclic())
+	vector<unsigned int> position;
+	vector<T> labels = labelPositions(position);
+	const size_t n = labels.size();
+	const int no_edge = (int) INFINITY;
+	
+	fill(matrix, matrix + n * n, no_edge);
+	
+	for(unsigned int v = 0; v < n; v++)
 	{
-		if(findVertex(source) != NULL)
+		int *row = matrix + position[v] * n;
+		
+		row[position[v]] = 0;
+		
+		for(typename Adjacency::const_iterator a = indexed_vertices[v]->adjacency().begin(); a != indexed_vertices[v]->adjacency().end(); a++)
 		{
-			vector<T> ord = topologicalSort();
-			const unsigned int sz = ord.size();
-			int pos = -1;
-			
-			assert(sz == numVertices());
-			
-			for(int i = 0; i < sz; i++)
-			{
-				if(ord[i] == source)
-				{
-					pos = i;
-					break;
-				}
-			}
-			
-			assert(pos != -1);
-			
-			for(int i = 0; i < sz; i++)
-			{
-				res[ord[i]] = make_pair(ord[i], (int) INFINITY);
-			}
-			
-			res[ord[pos]] = make_pair(ord[pos], 0);
-			
-			for(int i = pos; i < sz; i++)
-			{
-				Vertex *cur = findVertex(ord[i]);
-				
-				assert(cur != NULL);
-				
-				multiset<pair<Graph<T>::Vertex *, int> > adj = cur->getAdjacentNodes();
-				for(typename multiset<pair<Graph<T>::Vertex *, int> >::iterator a = adj.begin(); a != adj.end(); a++)
-				{
-					// First condition is checked to avoid overflow
-					if((res[ord[i]].second != (int) INFINITY) && (res[ord[i]].second + a->second < res[a->first->getLabel()].second))
-					{
-						res[a->first->getLabel()] = make_pair(ord[i], res[ord[i]].second + a->second);
-					}
-				}
-			}
+			row[position[a->first]] = a->second;
 		}
 	}
 	
-	return res;
+	return labels;
 }
 
 template <class T>
-map<T, pair<T, int> > Graph<T>::dijkstraShortestPath(T source) const
+pair<vector<T>, vector<vector<bool> > > Graph<T>::connectivityList() const
 {
-	map<T, pair<T, int> > res;
+	pair<vector<T>, BitMatrix> pr = connectivityBits();
+	const unsigned int n = pr.first.size();
+	vector<vector<bool> > res(n, vector<bool>(n));
 	
-	if(!hasNegativeWeightedEdge())
+	for(unsigned int i = 0; i < n; i++)
 	{
-		if(findVertex(source) != NULL)
+		for(unsigned int j = 0; j < n; j++)
 		{
-			map<T, bool> visited;
-			
-			for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-			{
-				res[itr->first] = make_pair(itr->first, (int) INFINITY);
-				visited[itr->first] = false;
-			}
-			
-			res[source] = make_pair(source, 0);
-
-			while(1)
-			{
-				// TODO: Try to use min heap
-				int min_dist = (int) INFINITY;
-				T curr;
-				
-				for(typename map<T, pair<T, int> >::const_iterator itr = res.begin(); itr != res.end(); itr++)
-				{
-					if(!visited[itr->first] && (itr->second.second < min_dist))
-					{
-						min_dist = itr->second.second;
-						curr = itr->first;
-					}
-				}
-				
-				if(min_dist == (int) INFINITY)
-				{
-					break;
-				}
-				
-				visited[curr] = true;
-				
-				assert(findVertex(curr) != NULL);
-				
-				multiset<pair<Vertex *, int> > adj = findVertex(curr)->getAdjacentNodes();
-				for(typename multiset<pair<Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
-				{
-					if(res[curr].second + a->second < res[a->first->getLabel()].second)
-					{
-						res[a->first->getLabel()] = make_pair(curr, res[curr].second + a->second);
-					}
-				}
-			}
+			res[i][j] = pr.second.get(i, j);
 		}
 	}
+
+	return make_pair(pr.first, res);
+}
+
+template <class T>
+pair<vector<T>, BitMatrix> Graph<T>::connectivityBits() const
+{
+	pair<vector<T>, BitMatrix> res;
+	
+	res.second.reset(numVertices(), numVertices());
+	res.first = connectivityList(res.second.data());
 	
 	return res;
 }
 
+// Writes the matrix to numVertices() rows of BitMatrix::wordsFor(numVertices()) words of the caller, laid out as in BitMatrix.
+// Every vertex is connected to itself
 template <class T>
-map<T, pair<T, int> > Graph<T>::bellmanFordShortestPath(T source) const
+vector<T> Graph<T>::connectivityList(uint64_t *bits) const
 {
-	map<T, pair<T, int> > emp, res;
-	int iter = numVertices() - 1;
-	
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-	{
-		res[itr->first] = make_pair(itr->first, (int) INFINITY);
-	}
+	vector<unsigned int> position;
+	vector<T> labels = labelPositions(position);
+	const size_t n = labels.size(), words = BitMatrix::wordsFor(n);
 	
-	res[source] = make_pair(source, 0);
+	fill(bits, bits + n * words, (uint64_t) 0);
 	
-	while(iter--)
+	for(unsigned int v = 0; v < n; v++)
 	{
-		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+		uint64_t *row = bits + position[v] * words;
+		
+		row[position[v] / 64] |= (uint64_t) 1 << (position[v] % 64);
+		
+		for(typename Adjacency::const_iterator a = indexed_vertices[v]->adjacency().begin(); a != indexed_vertices[v]->adjacency().end(); a++)
 		{
-			assert(itr->second != NULL);
+			unsigned int col = position[a->first];
 			
-			multiset<pair<Vertex *, int> > adj = itr->second->getAdjacentNodes();
-			for(typename multiset<pair<Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
-			{
-				// First condition is checked to avoid overflow
-				if((res[itr->first].second != (int) INFINITY) && (res[itr->first].second + a->second < res[a->first->getLabel()].second))
-				{
-					res[a->first->getLabel()] = make_pair(itr->first, res[itr->first].second + a->second);
-				}
-			}
+			row[col / 64] |= (uint64_t) 1 << (col % 64);
 		}
-	}	
+	}
 	
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	return labels;
+}
+
+// Entry (i, j) is the cost of an edge from the i-th vertex to the j-th, in the order of the labels, with one entry per copy
+// of the edge. An undirected edge gives both (i, j) and (j, i), a self loop only the one
+template <class T>
+pair<vector<T>, SparseMatrix<int> > Graph<T>::sparseMatrix() const
+{
+	vector<unsigned int> position;
+	vector<T> labels = labelPositions(position);
+	vector<unsigned int> rows, cols;
+	vector<int> values;
+	
+	for(unsigned int v = 0; v < indexed_vertices.size(); v++)
 	{
-		assert(itr->second != NULL);
-		
-		multiset<pair<Vertex *, int> > adj = itr->second->getAdjacentNodes();
-		for(typename multiset<pair<Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+		for(typename Adjacency::const_iterator a = indexed_vertices[v]->adjacency().begin(); a != indexed_vertices[v]->adjacency().end(); a++)
 		{
-			// First condition is checked to avoid overflow
-			if((res[itr->first].second != (int) INFINITY) && (res[itr->first].second + a->second < res[a->first->getLabel()].second))
-			{
-				// Graph contains negative cycle(s)
-				return emp;
-			}
+			rows.push_back(position[v]);
+			cols.push_back(position[a->first]);
+			values.push_back(a->second);
 		}
 	}
 	
-	return res;
+	return make_pair(labels, SparseMatrix<int>(labels.size(), labels.size(), rows, cols, values));
 }
 
+// Bit (i, j) is set if there is a path from the i-th vertex to the j-th, in the order of the labels. Every vertex reaches itself.
+// The rows of the strongly connected components are built from their successors', sinks first, by OR-ing whole words.
+// In parallel, the components at the same height above the sinks are done together
 template <class T>
-map<T, pair<T, int> > Graph<T>::shortestPath(T source) const
+pair<vector<T>, BitMatrix> Graph<T>::transitiveClosure(bool parallel) const
 {
-	map<T, pair<T, int> > res;
+	const unsigned int n = indexed_vertices.size();
+	vector<unsigned int> column;	// Vertex index -> position of its label
+	vector<T> labels = labelPositions(column);
 	
-	// Invalid source vertex
-	if(findVertex(source) == NULL)
+	// Condensation, every edge goes from a larger component to a smaller one
+	vector<unsigned int> component;
+	const unsigned int num_components = strongComponents(component);
+	vector<FlatEdge> edges = flatEdges();
+	vector<pair<unsigned int, unsigned int> > dag_edges;
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
 	{
-		return res;
+		if(component[e->src] != component[e->dest])
+		{
+			dag_edges.push_back(make_pair(component[e->src], component[e->dest]));
+		}
 	}
 	
-	res = bfsShortestPath(source);
+	sort(dag_edges.begin(), dag_edges.end());
+	dag_edges.erase(unique(dag_edges.begin(), dag_edges.end()), dag_edges.end());
 	
-	if(res.size() != 0)
+	vector<unsigned int> first(num_components + 1, 0);
+	
+	for(unsigned int i = 0; i < dag_edges.size(); i++)
 	{
-		return res;
+		first[dag_edges[i].first + 1]++;
 	}
 	
-	res = topologicalShortestPath(source);
-	
-	if(res.size() != 0)
+	for(unsigned int c = 0; c < num_components; c++)
 	{
-		return res;
+		first[c + 1] += first[c];
 	}
 	
-	res = dijkstraShortestPath(source);
+	BitMatrix reach(num_components, n);
 	
-	if(res.size() != 0)
+	for(unsigned int v = 0; v < n; v++)
 	{
-		return res;
+		reach.set(component[v], column[v]);
 	}
 	
-	// If the graph has negative cycles, it will be handled by Bellman-Ford algorithm
-	return bellmanFordShortestPath(source);
-}
-
-template <class T>
-pair<vector<T>, vector<vector<pair<T, int> > > > Graph<T>::shortestPath() const
-{
-	if(isSimple())
+	// Components grouped by their height above the sinks, the successors of a component are all lower
+	vector<unsigned int> height(num_components, 0);
+	vector<vector<unsigned int> > levels;
+	
+	for(unsigned int c = 0; c < num_components; c++)
 	{
-		pair<vector<T>, vector<vector<int> > > pr = adjacencyMatrix();
-		vector<vector<int> > curr_matrix = pr.second;
-		vector<vector<int> > prev_matrix;
-		vector<vector<pair<T, int> > > path;
-		const unsigned int n = numVertices();
-	
-		for(int i = 0; i < n; i++)
+		for(unsigned int i = first[c]; i < first[c + 1]; i++)
 		{
-			vector<pair<T, int> > tmp;
-			
-			for(int j = 0; j < n; j++)
-			{
-				tmp.push_back(make_pair(pr.first[j], (int) INFINITY));
-			}
-			
-			path.push_back(tmp);
+			height[c] = max(height[c], height[dag_edges[i].second] + 1);
 		}
 		
-		for(int k = 0; k < n; k++)
+		if(height[c] == levels.size())
 		{
-			prev_matrix = curr_matrix;
+			levels.push_back(vector<unsigned int>());
+		}
 		
-			for(int i = 0; i < n; i++)
+		levels[height[c]].push_back(c);
+	}
+	
+	for(unsigned int h = 0; h < levels.size(); h++)
+	{
+		const vector<unsigned int> &level = levels[h];
+		
+		// The grain is in rows, each of them n bits wide
+		parallelFor(0, level.size(), [&](size_t lo, size_t hi, unsigned int)
+		{
+			for(size_t i = lo; i < hi; i++)
 			{
-				for(int j = 0; j < n; j++)
+				for(unsigned int e = first[level[i]]; e < first[level[i] + 1]; e++)
 				{
-					// First two conditions are to avoid overflow
-					if((prev_matrix[i][k] == (int) INFINITY) || (prev_matrix[k][j] == (int) INFINITY) || (prev_matrix[i][j] <= prev_matrix[i][k] + prev_matrix[k][j]))
-					{
-						curr_matrix[i][j] = prev_matrix[i][j];
-						path[i][j] = make_pair(path[i][j].first, curr_matrix[i][j]);
-					}
-					else
-					{
-						curr_matrix[i][j] = prev_matrix[i][k] + prev_matrix[k][j];
-						path[i][j] = make_pair(pr.first[k], curr_matrix[i][j]);
-					}
+					reach.orRow(level[i], dag_edges[e].second);
 				}
 			}
+		}, parallel? max(PARALLEL_GRAIN / (reach.wordsPerRow() + 1), 1u): SERIAL_GRAIN);
+	}
+	
+	BitMatrix res(n, n);
+	
+	parallelFor(0, n, [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t v = lo; v < hi; v++)
+		{
+			copy(reach.row(component[v]), reach.row(component[v]) + reach.wordsPerRow(), res.row(column[v]));
 		}
+	}, parallel? max(PARALLEL_GRAIN / (res.wordsPerRow() + 1), 1u): SERIAL_GRAIN);
 	
-		return make_pair(pr.first, path);
+	return make_pair(labels, res);
+}
+
+template <class T>
+bool Graph<T>::isDirected() const
+{
+	return is_directed;
+}
+
+template <class T>
+bool Graph<T>::isWeighted() const
+{
+	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		Neighbours adj = getAdjacentNodes(itr->second);
+		for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			if(a->second != 1)
+			{	
+				return true;
+			}
+		}
 	}
 	
-	// Not a simple graph
-	return make_pair(vector<T>(), vector<vector<pair<T, int> > >());
+	return false;
 }
 
 template <class T>
-void Graph<T>::printPath(ostream &out, map<T, pair<T, int> > path) const
+bool Graph<T>::isConnected() const
 {
-	for(typename map<T, pair<T, int> >::const_iterator itr = path.begin(); itr != path.end(); itr++)
+	if(numVertices() <= 1)
 	{
-		out << itr->first << " =====> ";
+		return true;
+	}
+	
+	// Strongly connected, if every vertex is reached from some vertex both along and against the edges
+	if(is_directed)
+	{
+		return countReachable(0, false) == numVertices() && countReachable(0, true) == numVertices();
+	}
 		
-		if(itr->second.second == (int) INFINITY)
+	// Undirected graph
+	if(connectivity_enabled)
+	{
+		return numComponents() == 1;
+	}
+	
+	T src = vertices.begin()->first;
+	vector<T> traversed = dfs(src);
+	
+	return traversed.size() == vertices.size();
+}
+
+// Breadth first search over the vertex indices, against the edges if backwards
+template <class T>
+unsigned int Graph<T>::countReachable(unsigned int start, bool backwards) const
+{
+	vector<bool> visited(indexed_vertices.size(), false);
+	vector<unsigned int> q(1, start);
+	
+	visited[start] = true;
+	
+	for(unsigned int head = 0; head < q.size(); head++)
+	{
+		Vertex *v = indexed_vertices[q[head]];
+		
+		if(backwards)
 		{
-			out << "(Unreachable)" << endl;
+			for(typename Adjacency::const_iterator r = v->reverseAdjacency().begin(); r != v->reverseAdjacency().end(); r++)
+			{
+				if(!visited[r->first])
+				{
+					visited[r->first] = true;
+					q.push_back(r->first);
+				}
+			}
 		}
 		else
 		{
-			stack<T> stk;
-			
-			T curr = itr->first;
-			T prev;
-			
-			do
-			{
-				prev = curr;
-				stk.push(curr);
-				curr = path[curr].first;
-			}while(prev != curr);
-			
-			while(!stk.empty())
+			for(typename Adjacency::const_iterator a = v->adjacency().begin(); a != v->adjacency().end(); a++)
 			{
-				out << stk.top() << ", ";
-				stk.pop();
+				if(!visited[a->first])
+				{
+					visited[a->first] = true;
+					q.push_back(a->first);
+				}
 			}
-			
-			out << "\b\b (" << itr->second.second << ")" << endl; 
 		}
 	}
+	
+	return q.size();
 }
 
 template <class T>
-void Graph<T>::printPath(ostream &out, pair<vector<T>, vector<vector<pair<T, int> > > > dist) const
+bool Graph<T>::isAcyclic() const
 {
-	const int n = numVertices();
+	if(numVertices() == 0)
+	{
+		return true;
+	}
 	
-	assert(dist.first.size() == n);
+	vector<T> cycle;
 	
-	out << "Path: " << endl;
-		
-	for(int i = 0; i < n; i++)
+	if(is_directed)
 	{
-		out << "\t" << i+1;
+		return !findDirectedCycle(cycle);
 	}
 	
-	out << endl;
+	// Undirected graph
+	if(numEdges() > numVertices() - 1)
+	{
+		return false;
+	}
+	
+	return !findUndirectedCycle(cycle);
+}
 
-	for(int i = 0; i < n; i++)
+// On a cyclic graph, cycle holds the vertices of one cycle in their order around it
+template <class T>
+bool Graph<T>::isAcyclic(vector<T> &cycle) const
+{
+	cycle.clear();
+	
+	if(is_directed)
 	{
-		out << "____________";
+		return !findDirectedCycle(cycle);
 	}
 	
-	out << endl;
+	return !findUndirectedCycle(cycle);
+}
+
+// Iterative three colour DFS, which stops at the first back edge. The grey vertices are
+// exactly the ones on the stack, so the cycle is read off the stack from the head of the back edge
+template <class T>
+bool Graph<T>::findDirectedCycle(vector<T> &cycle) const
+{
+	typedef typename Adjacency::const_iterator AdjIterator;
 	
-	for(int i = 0; i < n; i++)
+	enum Colour {WHITE, GREY, BLACK};
+	
+	struct Frame
 	{
-		out << dist.first[i] << "(" << i+1 << ") | ";
+		unsigned int vertex;
+		AdjIterator next, end;
+	};
+	
+	const unsigned int n = indexed_vertices.size();
+	vector<unsigned char> colour(n, WHITE);
+	vector<Frame> st;
+	
+	for(unsigned int root = 0; root < n; root++)
+	{
+		if(colour[root] != WHITE)
+		{
+			continue;
+		}
 		
-		for(int j = 0; j < n; j++)
+		Frame f = {root, indexed_vertices[root]->adjacency().begin(), indexed_vertices[root]->adjacency().end()};
+		
+		colour[root] = GREY;
+		st.push_back(f);
+		
+		while(!st.empty())
 		{
-			if(dist.second[i][j].second == (int) INFINITY)
+			Frame &top = st.back();
+			
+			if(top.next == top.end)
 			{
-				out << "\t---";
+				colour[top.vertex] = BLACK;
+				st.pop_back();
+				continue;
 			}
-			else
+			
+			unsigned int w = (top.next++)->first;
+			
+			if(colour[w] == GREY)
 			{
-				out << "\t" << dist.second[i][j].first;
+				unsigned int pos = st.size() - 1;
+				
+				while(st[pos].vertex != w)
+				{
+					pos--;
+				}
+				
+				for(; pos < st.size(); pos++)
+				{
+					cycle.push_back(indexed_vertices[st[pos].vertex]->getLabel());
+				}
+				
+				return true;
+			}
+			
+			if(colour[w] == WHITE)
+			{
+				Frame child = {w, indexed_vertices[w]->adjacency().begin(), indexed_vertices[w]->adjacency().end()};
+				
+				colour[w] = GREY;
+				st.push_back(child);
 			}
 		}
-		
-		out << endl;
-	}
-	
-	out << "Distance: " << endl;
-	
-	for(int i = 0; i < n; i++)
-	{
-		out << "\t" << i+1;
 	}
 	
-	out << endl;
+	return false;
+}
+
+// Iterative DFS on the graph itself. The tree edge to the parent is skipped once, so another
+// copy of it is a cycle of length two. The first non tree edge found always leads to an ancestor
+template <class T>
+bool Graph<T>::findUndirectedCycle(vector<T> &cycle) const
+{
+	typedef typename Adjacency::const_iterator AdjIterator;
 	
-	for(int i = 0; i < n; i++)
+	struct Frame
 	{
-		out << "____________";
-	}
+		unsigned int vertex;
+		AdjIterator next, end;
+		bool parent_skipped;
+	};
 	
-	out << endl;
+	const unsigned int n = indexed_vertices.size();
+	vector<int> parent(n, -1);
+	vector<bool> visited(n, false);
+	vector<Frame> st;
 	
-	for(int i = 0; i < n; i++)
+	for(unsigned int root = 0; root < n; root++)
 	{
-		out << dist.first[i] << "(" << i+1 << ") | ";
+		if(visited[root])
+		{
+			continue;
+		}
 		
-		for(int j = 0; j < n; j++)
+		Frame f = {root, indexed_vertices[root]->adjacency().begin(), indexed_vertices[root]->adjacency().end(), false};
+		
+		visited[root] = true;
+		st.push_back(f);
+		
+		while(!st.empty())
 		{
-			if(dist.second[i][j].second == (int) INFINITY)
+			Frame &top = st.back();
+			
+			if(top.next == top.end)
 			{
-				out << "\tinf";
+				st.pop_back();
+				continue;
 			}
-			else
+			
+			unsigned int v = top.vertex;
+			unsigned int w = (top.next++)->first;
+			
+			if((int) w == parent[v] && !top.parent_skipped)
 			{
-				out << "\t" << dist.second[i][j].second;
+				top.parent_skipped = true;
+				continue;
 			}
+			
+			if(visited[w])
+			{
+				// Back edge from v to its ancestor w, or a self loop when both are the same
+				for(unsigned int u = v; u != w; u = parent[u])
+				{
+					cycle.push_back(indexed_vertices[u]->getLabel());
+				}
+				
+				cycle.push_back(indexed_vertices[w]->getLabel());
+				std::reverse(cycle.begin(), cycle.end());
+				
+				return true;
+			}
+			
+			Frame child = {w, indexed_vertices[w]->adjacency().begin(), indexed_vertices[w]->adjacency().end(), false};
+			
+			visited[w] = true;
+			parent[w] = v;
+			st.push_back(child);
 		}
-		
-		out << endl;
 	}
+	
+	return false;
 }
 
-template <class T>		
-vector<T> Graph<T>::getVertices() const
+// Single pass over the adjacencies, stops at the first offending edge if nothing is to be reported
+template <class T>
+bool Graph<T>::findNonSimpleEdges(vector<T> *self_loops, vector<pair<T, T> > *parallel_edges) const
 {
-	vector<T> res;
+	bool simple = true;
 	
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
 	{
-		res.push_back(itr->first);
+		const Adjacency &adj = itr->second->adjacency();
+		typename Adjacency::const_iterator a = adj.begin();
+		
+		// Copies of an edge are next to each other in the adjacency
+		while(a != adj.end())
+		{
+			Vertex *dest = indexed_vertices[a->first];
+			unsigned int copies = 0;
+			
+			for(; a != adj.end() && a->first == dest->getIndex(); a++)
+			{
+				copies++;
+			}
+			
+			if(dest == itr->second)
+			{
+				simple = false;
+				
+				if(self_loops != NULL)
+				{
+					self_loops->push_back(itr->first);
+				}
+			}
+			else if(copies > 1 && (is_directed || itr->first < dest->getLabel()))	// Undirected pairs are reported from one end
+			{
+				simple = false;
+				
+				if(parallel_edges != NULL)
+				{
+					parallel_edges->push_back(make_pair(itr->first, dest->getLabel()));
+				}
+			}
+			
+			if(!simple && self_loops == NULL && parallel_edges == NULL)
+			{
+				return false;
+			}
+		}
 	}
 	
-	return res;
+	return simple;
 }
 
 template <class T>
-vector<Edge<T> *> Graph<T>::getEdges() const
+bool Graph<T>::isSimple() const
 {
-	vector<Edge<T> *> res;
+	return findNonSimpleEdges(NULL, NULL);
+}
+
+// Lists every vertex with a self loop, and every pair of vertices with more than one edge between them
+template <class T>
+bool Graph<T>::isSimple(vector<T> &self_loops, vector<pair<T, T> > &parallel_edges) const
+{
+	self_loops.clear();
+	parallel_edges.clear();
+	
+	bool simple = findNonSimpleEdges(&self_loops, &parallel_edges);
+	
+	sort(parallel_edges.begin(), parallel_edges.end());
+	
+	return simple;
+}
+
+template <class T>
+bool Graph<T>::hasNegativeWeightedEdge() const
+{
+	for(typename map<T, Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		if(itr->second->hasNegativeWeightedEdge())
+		{
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+template <class T>
+map<T, pair<T, int> > Graph<T>::bfsShortestPath(T source) const
+{
+	map<T, pair<T, int> > res;
+	
+	if(!isDirected() && !isWeighted())
+	{
+		Vertex *vtx = findVertex(source);
+
+		if(vtx != NULL)
+		{
+			// Create and initialize table
+			map<T, bool> visited;
+			for(typename map<T, typename Graph<T>::Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+			{
+				visited[itr->first] = false;
+			}
+	
+			queue<pair<Vertex *, pair<T, int> > > q;
+	
+			q.push(make_pair(vtx, make_pair(source, 0)));
+	
+			while(!q.empty())
+			{
+				pair<Vertex *, pair<T, int> > pr = q.front();
+				q.pop();
+		
+				if(!visited[pr.first->getLabel()])
+				{
+					res[pr.first->getLabel()] = pr.second;
+					visited[pr.first->getLabel()] = true;
+	
+					Neighbours adj = getAdjacentNodes(pr.first);
+					for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+					{
+						q.push(make_pair(a->first, make_pair(pr.first->getLabel(), pr.second.second + 1)));
+					}
+				}
+			}
+			
+			for(typename map<T, bool>::const_iterator itr = visited.begin(); itr != visited.end(); itr++)
+			{
+				if(!itr->second)
+				{
+					res[itr->first] = make_pair(itr->first, (int) INFINITY);
+				}
+			}
+		}	
+	}
+	
+	return res;
+}
+
+template <class T>
+map<T, pair<T, int> > Graph<T>::topologicalShortestPath(T source) const
+{
+	map<T, pair<T, int> > res;
+	
+	if(isDirected() && isAcyclic())
+	{
+		if(findVertex(source) != NULL)
+		{
+			vector<T> ord = topologicalSort();
+			const unsigned int sz = ord.size();
+			int pos = -1;
+			
+			assert(sz == numVertices());
+			
+			for(int i = 0; i < sz; i++)
+			{
+				if(ord[i] == source)
+				{
+					pos = i;
+					break;
+				}
+			}
+			
+			assert(pos != -1);
+			
+			for(int i = 0; i < sz; i++)
+			{
+				res[ord[i]] = make_pair(ord[i], (int) INFINITY);
+			}
+			
+			res[ord[pos]] = make_pair(ord[pos], 0);
+			
+			for(int i = pos; i < sz; i++)
+			{
+				Vertex *cur = findVertex(ord[i]);
+				
+				assert(cur != NULL);
+				
+				Neighbours adj = getAdjacentNodes(cur);
+				for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+				{
+					// First condition is checked to avoid overflow
+					if((res[ord[i]].second != (int) INFINITY) && (res[ord[i]].second + a->second < res[a->first->getLabel()].second))
+					{
+						res[a->first->getLabel()] = make_pair(ord[i], res[ord[i]].second + a->second);
+					}
+				}
+			}
+		}
+	}
+	
+	return res;
+}
+
+template <class T>
+map<T, pair<T, int> > Graph<T>::dijkstraShortestPath(T source) const
+{
+	map<T, pair<T, int> > res;
+	
+	if(!hasNegativeWeightedEdge())
+	{
+		if(findVertex(source) != NULL)
+		{
+			map<T, bool> visited;
+			
+			for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+			{
+				res[itr->first] = make_pair(itr->first, (int) INFINITY);
+				visited[itr->first] = false;
+			}
+			
+			res[source] = make_pair(source, 0);
+
+			while(1)
+			{
+				// TODO: Try to use min heap
+				int min_dist = (int) INFINITY;
+				T curr;
+				
+				for(typename map<T, pair<T, int> >::const_iterator itr = res.begin(); itr != res.end(); itr++)
+				{
+					if(!visited[itr->first] && (itr->second.second < min_dist))
+					{
+						min_dist = itr->second.second;
+						curr = itr->first;
+					}
+				}
+				
+				if(min_dist == (int) INFINITY)
+				{
+					break;
+				}
+				
+				visited[curr] = true;
+				
+				assert(findVertex(curr) != NULL);
+				
+				Neighbours adj = getAdjacentNodes(findVertex(curr));
+				for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+				{
+					if(res[curr].second + a->second < res[a->first->getLabel()].second)
+					{
+						res[a->first->getLabel()] = make_pair(curr, res[curr].second + a->second);
+					}
+				}
+			}
+		}
+	}
+	
+	return res;
+}
+
+template <class T>
+map<T, pair<T, int> > Graph<T>::bellmanFordShortestPath(T source) const
+{
+	map<T, pair<T, int> > emp, res;
+	int iter = numVertices() - 1;
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		res[itr->first] = make_pair(itr->first, (int) INFINITY);
+	}
+	
+	res[source] = make_pair(source, 0);
+	
+	while(iter--)
+	{
+		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+		{
+			assert(itr->second != NULL);
+			
+			Neighbours adj = getAdjacentNodes(itr->second);
+			for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+			{
+				// First condition is checked to avoid overflow
+				if((res[itr->first].second != (int) INFINITY) && (res[itr->first].second + a->second < res[a->first->getLabel()].second))
+				{
+					res[a->first->getLabel()] = make_pair(itr->first, res[itr->first].second + a->second);
+				}
+			}
+		}
+	}	
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		assert(itr->second != NULL);
+		
+		Neighbours adj = getAdjacentNodes(itr->second);
+		for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			// First condition is checked to avoid overflow
+			if((res[itr->first].second != (int) INFINITY) && (res[itr->first].second + a->second < res[a->first->getLabel()].second))
+			{
+				// Graph contains negative cycle(s)
+				return emp;
+			}
+		}
+	}
+	
+	return res;
+}
+
+template <class T>
+map<T, pair<T, int> > Graph<T>::shortestPath(T source) const
+{
+	map<T, pair<T, int> > res;
+	
+	// Invalid source vertex
+	if(findVertex(source) == NULL)
+	{
+		return res;
+	}
+	
+	res = bfsShortestPath(source);
+	
+	if(res.size() != 0)
+	{
+		return res;
+	}
+	
+	res = topologicalShortestPath(source);
+	
+	if(res.size() != 0)
+	{
+		return res;
+	}
+	
+	res = dijkstraShortestPath(source);
+	
+	if(res.size() != 0)
+	{
+		return res;
+	}
+	
+	// If the graph has negative cycles, it will be handled by Bellman-Ford algorithm
+	return bellmanFordShortestPath(source);
+}
+
+template <class T>
+pair<vector<T>, vector<vector<pair<T, int> > > > Graph<T>::shortestPath() const
+{
+	if(isSimple())
+	{
+		pair<vector<T>, vector<vector<int> > > pr = adjacencyMatrix();
+		vector<vector<int> > curr_matrix = pr.second;
+		vector<vector<int> > prev_matrix;
+		vector<vector<pair<T, int> > > path;
+		const unsigned int n = numVertices();
+	
+		for(int i = 0; i < n; i++)
+		{
+			vector<pair<T, int> > tmp;
+			
+			for(int j = 0; j < n; j++)
+			{
+				tmp.push_back(make_pair(pr.first[j], (int) INFINITY));
+			}
+			
+			path.push_back(tmp);
+		}
+		
+		for(int k = 0; k < n; k++)
+		{
+			prev_matrix = curr_matrix;
+		
+			for(int i = 0; i < n; i++)
+			{
+				for(int j = 0; j < n; j++)
+				{
+					// First two conditions are to avoid overflow
+					if((prev_matrix[i][k] == (int) INFINITY) || (prev_matrix[k][j] == (int) INFINITY) || (prev_matrix[i][j] <= prev_matrix[i][k] + prev_matrix[k][j]))
+					{
+						curr_matrix[i][j] = prev_matrix[i][j];
+						path[i][j] = make_pair(path[i][j].first, curr_matrix[i][j]);
+					}
+					else
+					{
+						curr_matrix[i][j] = prev_matrix[i][k] + prev_matrix[k][j];
+						path[i][j] = make_pair(pr.first[k], curr_matrix[i][j]);
+					}
+				}
+			}
+		}
+	
+		return make_pair(pr.first, path);
+	}
+	
+	// Not a simple graph
+	return make_pair(vector<T>(), vector<vector<pair<T, int> > >());
+}
+
+template <class T>
+void Graph<T>::printPath(ostream &out, map<T, pair<T, int> > path) const
+{
+	for(typename map<T, pair<T, int> >::const_iterator itr = path.begin(); itr != path.end(); itr++)
+	{
+		out << itr->first << " =====> ";
+		
+		if(itr->second.second == (int) INFINITY)
+		{
+			out << "(Unreachable)" << endl;
+		}
+		else
+		{
+			stack<T> stk;
+			
+			T curr = itr->first;
+			T prev;
+			
+			do
+			{
+				prev = curr;
+				stk.push(curr);
+				curr = path[curr].first;
+			}while(prev != curr);
+			
+			while(!stk.empty())
+			{
+				out << stk.top() << ", ";
+				stk.pop();
+			}
+			
+			out << "\b\b (" << itr->second.second << ")" << endl; 
+		}
+	}
+}
+
+template <class T>
+void Graph<T>::printPath(ostream &out, pair<vector<T>, vector<vector<pair<T, int> > > > dist) const
+{
+	const int n = numVertices();
+	
+	assert(dist.first.size() == n);
+	
+	out << "Path: " << endl;
+		
+	for(int i = 0; i < n; i++)
+	{
+		out << "\t" << i+1;
+	}
+	
+	out << endl;
+
+	for(int i = 0; i < n; i++)
+	{
+		out << "____________";
+	}
+	
+	out << endl;
+	
+	for(int i = 0; i < n; i++)
+	{
+		out << dist.first[i] << "(" << i+1 << ") | ";
+		
+		for(int j = 0; j < n; j++)
+		{
+			if(dist.second[i][j].second == (int) INFINITY)
+			{
+				out << "\t---";
+			}
+			else
+			{
+				out << "\t" << dist.second[i][j].first;
+			}
+		}
+		
+		out << endl;
+	}
+	
+	out << "Distance: " << endl;
+	
+	for(int i = 0; i < n; i++)
+	{
+		out << "\t" << i+1;
+	}
+	
+	out << endl;
+	
+	for(int i = 0; i < n; i++)
+	{
+		out << "____________";
+	}
+	
+	out << endl;
+	
+	for(int i = 0; i < n; i++)
+	{
+		out << dist.first[i] << "(" << i+1 << ") | ";
+		
+		for(int j = 0; j < n; j++)
+		{
+			if(dist.second[i][j].second == (int) INFINITY)
+			{
+				out << "\tinf";
+			}
+			else
+			{
+				out << "\t" << dist.second[i][j].second;
+			}
+		}
+		
+		out << endl;
+	}
+}
+
+template <class T>		
+vector<T> Graph<T>::getVertices() const
+{
+	vector<T> res;
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		res.push_back(itr->first);
+	}
+	
+	return res;
+}
+
+// Every edge is allocated on its own and left to the caller to delete, an undirected one is listed from both the endpoints.
+// edges(), forEachEdge() and exportEdges() do without the allocations
+template <class T>
+vector<Edge<T> *> Graph<T>::getEdges() const
+{
+	vector<Edge<T> *> res;
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		const Adjacency &adj = itr->second->adjacency();
+		
+		for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			res.push_back(new Edge<T>(itr->first, indexed_vertices[a->first]->getLabel(), a->second));
+		}
+	}
+		
+	return res;
+}
+
+template <class T>
+typename Graph<T>::EdgeRange Graph<T>::edges() const
+{
+	return EdgeRange(vertices, indexed_vertices, is_directed);
+}
+
+// Calls fn(src, dest, cost) for every edge, in the order of edges()
+template <class T>
+template <class Function>
+void Graph<T>::forEachEdge(Function fn) const
+{
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		const Adjacency &adj = itr->second->adjacency();
+		
+		for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+		{
+			if(is_directed || !(indexed_vertices[a->first]->getLabel() < itr->first))
+			{
+				fn(itr->first, indexed_vertices[a->first]->getLabel(), a->second);
+			}
+		}
+	}
+}
+
+// Replaces the contents of res with the edges, in the order of edges(). The capacity of res is reused
+template <class T>
+void Graph<T>::exportEdges(vector<Edge<T> > &res) const
+{
+	res.clear();
+	res.reserve(numEdges());
+	
+	forEachEdge([&res](const T &src, const T &dest, int cost)
+	{
+		res.push_back(Edge<T>(src, dest, cost));
+	});
+}
+
+template <class T>
+vector<vector<T> > Graph<T>::getVerticesComponentwise() const
+{
+	vector<vector<T> > res;
+	
+	if(isDirected())	// Kosaraju's algorithm for finding Strongly Connected Components (SCCs) in a directed graph
+	{
+		stack<T> finished_vertices;
+		map<T, bool> visited;
+		
+		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+		{
+			visited[itr->first] = false;
+		}
+		
+		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+		{
+			if(!visited[itr->first])
+			{
+				findFinishOrder(itr->first, finished_vertices, visited);
+			}
+		}
+		
+		// The second pass walks the incoming edges, so the reverse graph is not needed
+		vector<bool> assigned(indexed_vertices.size(), false);
+		
+		while(!finished_vertices.empty())
+		{
+			unsigned int curr = findVertex(finished_vertices.top())->getIndex();
+			finished_vertices.pop();
+			
+			if(!assigned[curr])
+			{
+				vector<T> vlist;
+				stack<unsigned int> stk;
+				
+				stk.push(curr);
+				
+				while(!stk.empty())
+				{
+					unsigned int v = stk.top();
+					stk.pop();
+					
+					if(!assigned[v])
+					{
+						const Adjacency &in = indexed_vertices[v]->reverseAdjacency();
+						
+						assigned[v] = true;
+						vlist.push_back(indexed_vertices[v]->getLabel());
+						
+						for(typename Adjacency::const_iterator r = in.begin(); r != in.end(); r++)
+						{
+							if(!assigned[r->first])
+							{
+								stk.push(r->first);
+							}
+						}
+					}
+				}
+
+				res.push_back(vlist);
+			}
+		}
+		
+		return res;
+	}
+	
+	// Undirected graph
+	if(connectivity_enabled)
+	{
+		refreshConnectivity();
+		return groupBySet(connectivity);
+	}
+	
+	// Union of the endpoints of every edge, the vertex ranges are scanned concurrently
+	ConcurrentDisjointSet s(indexed_vertices.size());
+	
+	parallelFor(0, indexed_vertices.size(), [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t i = lo; i < hi; i++)
+		{
+			const Adjacency &adj = indexed_vertices[i]->adjacency();
+			
+			for(typename Adjacency::const_iterator a = adj.begin(); a != adj.end(); a++)
+			{
+				// Each edge is stored in both the endpoints, one of them is enough
+				if(i < a->first)
+				{
+					s.join(i, a->first);
+				}
+			}
+		}
+	});
+	
+	return groupBySet(s);
+}
+
+template <class T>
+template <class Sets>
+vector<vector<T> > Graph<T>::groupBySet(Sets &s) const
+{
+	vector<vector<T> > res;
+	
+	// Sets are listed in the order of their smallest label, and so are their vertices
+	vector<int> set_of_root(indexed_vertices.size(), -1);
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		unsigned int root = s.find(itr->second->getIndex());
+		
+		if(set_of_root[root] == -1)
+		{
+			set_of_root[root] = res.size();
+			res.push_back(vector<T>());
+		}
+		
+		res[set_of_root[root]].push_back(itr->first);
+	}
+	
+	return res;
+}
+
+template <class T>
+void Graph<T>::refreshConnectivity() const
+{
+	assert(!is_directed);
+	
+	// Without the index, nothing keeps the sets up to date, so they are recomputed on every query
+	if(connectivity_stale || !connectivity_enabled)
+	{
+		vector<FlatEdge> edges = flatEdges();
+		
+		connectivity.reset(indexed_vertices.size());
+		
+		for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
+		{
+			connectivity.insertEdge(e->src, e->dest);
+		}
+		
+		connectivity_stale = false;
+	}
+}
+
+template <class T>
+bool Graph<T>::enableConnectivityIndex()
+{
+	// Only undirected graphs are supported
+	if(is_directed)
+	{
+		return false;
+	}
+	
+	if(!connectivity_enabled)
+	{
+		connectivity_enabled = true;
+		connectivity_stale = true;
+	}
+	
+	return true;
+}
+
+template <class T>
+void Graph<T>::disableConnectivityIndex()
+{
+	connectivity_enabled = false;
+	connectivity.reset(0);
+}
+
+template <class T>
+bool Graph<T>::connected(T first, T second) const
+{
+	Vertex *ft = findVertex(first);
+	Vertex *sd = findVertex(second);
+	
+	if((ft == NULL) || (sd == NULL))
+	{
+		return false;
+	}
+	
+	if(is_directed)	// Strongly connected
+	{
+		return pathExists(first, second) && pathExists(second, first);
+	}
+	
+	refreshConnectivity();
+	
+	return connectivity.connected(ft->getIndex(), sd->getIndex());
+}
+
+template <class T>
+T Graph<T>::componentOf(T label) const
+{
+	Vertex *vtx = findVertex(label);
+	
+	// Label does not exist
+	if(vtx == NULL)
+	{
+		return label;
+	}
+	
+	if(is_directed)	// First vertex of the strongly connected component
+	{
+		vector<vector<T> > comp = getVerticesComponentwise();
+		
+		for(typename vector<vector<T> >::const_iterator i = comp.begin(); i != comp.end(); i++)
+		{
+			if(find(i->begin(), i->end(), label) != i->end())
+			{
+				return i->front();
+			}
+		}
+		
+		return label;
+	}
+	
+	refreshConnectivity();
+	
+	return indexed_vertices[connectivity.find(vtx->getIndex())]->getLabel();
+}
+
+template <class T>
+unsigned int Graph<T>::numComponents() const
+{
+	if(is_directed)
+	{
+		return getVerticesComponentwise().size();
+	}
+	
+	refreshConnectivity();
+	
+	return connectivity.numSets();
+}
+
+// Returns false if there is no order to keep, because the graph is undirected or has a cycle (which only mergeVertices() can close)
+template <class T>
+bool Graph<T>::refreshTopologicalOrder() const
+{
+	if(!is_directed)
+	{
+		return false;
+	}
+	
+	if(topological_order_stale)
+	{
+		vector<unsigned int> ready;
+		
+		if(!kahnOrder(ready))
+		{
+			return false;
+		}
+		
+		// Edges are inserted into an order which already agrees with them, so none is moved
+		vector<FlatEdge> edges = flatEdges();
+		
+		topological_order.reset(ready);
+		
+		for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
+		{
+			topological_order.insertEdge(e->src, e->dest);
+		}
+		
+		topological_order_stale = false;
+	}
+	
+	return true;
+}
+
+// From now on, addEdge() refuses the edges that would close a cycle.
+// Returns false if the graph is undirected or already has a cycle
+template <class T>
+bool Graph<T>::enableTopologicalOrder()
+{
+	if(!is_directed)
+	{
+		return false;
+	}
+	
+	if(!topological_order_enabled)
+	{
+		topological_order_enabled = true;
+		topological_order_stale = true;
+	}
+	
+	if(!refreshTopologicalOrder())
+	{
+		disableTopologicalOrder();
+		return false;
+	}
+	
+	return true;
+}
+
+template <class T>
+void Graph<T>::disableTopologicalOrder()
+{
+	topological_order_enabled = false;
+	topological_order.reset(vector<unsigned int>());
+}
+
+// Empty if the graph is undirected or has a cycle
+template <class T>
+vector<T> Graph<T>::topologicalOrder() const
+{
+	vector<T> res;
+	
+	// Without the index, the order is computed from scratch
+	if(!topological_order_enabled)
+	{
+		if(!topologicalSort(res))
+		{
+			res.clear();
+		}
+		
+		return res;
+	}
+	
+	if(!refreshTopologicalOrder())
+	{
+		return res;
+	}
+	
+	vector<unsigned int> order = topological_order.order();
+	
+	res.reserve(order.size());
+	
+	for(unsigned int i = 0; i < order.size(); i++)
+	{
+		res.push_back(indexed_vertices[order[i]]->getLabel());
+	}
+	
+	return res;
+}
+
+// Iterative Tarjan over the vertex indices. Components are numbered in the order they are completed,
+// so every edge between two components goes from the larger number to the smaller one.
+// Undirected edges are stored both ways, so these are the connected components of an undirected graph
+template <class T>
+unsigned int Graph<T>::strongComponents(vector<unsigned int> &component) const
+{
+	typedef typename Adjacency::const_iterator AdjIterator;
+	
+	struct Frame
+	{
+		unsigned int vertex;
+		AdjIterator next, end;
+	};
+	
+	const unsigned int n = indexed_vertices.size();
+	vector<unsigned int> order(n, UINT_MAX), lowlink(n);
+	vector<unsigned int> open;	// Vertices whose component is not complete yet
+	vector<bool> is_open(n, false);
+	vector<Frame> st;
+	unsigned int counter = 0, num_components = 0;
+	
+	component.assign(n, 0);
+	
+	for(unsigned int root = 0; root < n; root++)
+	{
+		if(order[root] != UINT_MAX)
+		{
+			continue;
+		}
+		
+		Frame f = {root, indexed_vertices[root]->adjacency().begin(), indexed_vertices[root]->adjacency().end()};
+		
+		order[root] = lowlink[root] = counter++;
+		open.push_back(root);
+		is_open[root] = true;
+		st.push_back(f);
+		
+		while(!st.empty())
+		{
+			Frame &top = st.back();
+			unsigned int v = top.vertex;
+			
+			if(top.next != top.end)
+			{
+				unsigned int w = (top.next++)->first;
+				
+				if(order[w] == UINT_MAX)
+				{
+					Frame child = {w, indexed_vertices[w]->adjacency().begin(), indexed_vertices[w]->adjacency().end()};
+					
+					order[w] = lowlink[w] = counter++;
+					open.push_back(w);
+					is_open[w] = true;
+					st.push_back(child);
+				}
+				else if(is_open[w])
+				{
+					lowlink[v] = min(lowlink[v], order[w]);
+				}
+				
+				continue;
+			}
+			
+			st.pop_back();
+			
+			if(lowlink[v] == order[v])
+			{
+				unsigned int w;
+				
+				do
+				{
+					w = open.back();
+					open.pop_back();
+					is_open[w] = false;
+					component[w] = num_components;
+				}
+				while(w != v);
+				
+				num_components++;
+			}
+			
+			if(!st.empty())
+			{
+				lowlink[st.back().vertex] = min(lowlink[st.back().vertex], lowlink[v]);
+			}
+		}
+	}
+	
+	return num_components;
+}
+
+template <class T>
+void Graph<T>::refreshReachability() const
+{
+	if(!reachability_stale)
+	{
+		return;
+	}
+	
+	vector<unsigned int> component;
+	unsigned int num_components = strongComponents(component);
+	vector<FlatEdge> edges = flatEdges();
+	vector<pair<unsigned int, unsigned int> > dag_edges;
+	
+	dag_edges.reserve(edges.size());
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
+	{
+		// An undirected edge never leaves its component
+		if(component[e->src] != component[e->dest])
+		{
+			dag_edges.push_back(make_pair(component[e->src], component[e->dest]));
+		}
+	}
+	
+	reachability.build(component, num_components, dag_edges, reachability_intervals);
+	reachability_stale = false;
+}
+
+// From now on, pathExists() answers from interval labels, which are rebuilt lazily after every modification of the graph.
+// More intervals answer more of the negative queries without a search, at the cost of memory
+template <class T>
+void Graph<T>::enableReachabilityIndex(unsigned int num_intervals)
+{
+	reachability_enabled = true;
+	reachability_stale = true;
+	reachability_intervals = max(num_intervals, 1u);
+}
+
+template <class T>
+void Graph<T>::disableReachabilityIndex()
+{
+	reachability_enabled = false;
+	reachability_stale = true;
+	reachability = ReachabilityIndex();
+}
+
+template <class T>
+vector<Graph<T> *> Graph<T>::getConnectedComponents() const
+{
+	vector<Graph<T> *> res;
+	vector<vector<T> > vertices_compwise = getVerticesComponentwise();
+	
+	for(typename vector<vector<T> >::const_iterator i = vertices_compwise.begin(); i != vertices_compwise.end(); i++)
+	{
+		Graph<T> *g = new Graph<T>(is_directed);
+		
+		for(typename vector<T>::const_iterator j = i->begin(); j != i->end(); j++)
+		{
+			g->addVertex(*j);
+		}
+		
+		for(typename vector<T>::const_iterator j = i->begin(); j != i->end(); j++)
+		{
+			Neighbours adj = getAdjacentNodes(findVertex(*j));
+			
+			for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+			{
+				// Graph::addEdge() is intentionally not called here
+				Vertex *src = g->findVertex(*j);
+				Vertex *dest = g->findVertex(a->first->getLabel());
+				
+				if(src != NULL && dest != NULL)
+				{
+					src->addEdge(dest, a->second);
+				}
+			}
+		}
+		
+		res.push_back(g);
+	}
+	
+	return res;
+}
+
+template <class T>
+Graph<T> Graph<T>::minimumSpanningTree() const
+{
+	Graph<T> t(is_directed);
+	
+	if(!isDirected() && isConnected())
+	{
+		if(vertices.size() != 0)
+		{
+			map<T, bool> visited;
+			
+			for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+			{
+				visited[itr->first] = false;
+				t.addVertex(itr->first);
+			}
+			
+			visited[vertices.begin()->first] = true;
+
+			while(1)
+			{
+				int min_dist = (int) INFINITY;
+				pair<T, T> curr;
+				
+				for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+				{
+					if(visited[itr->first])
+					{
+						Neighbours adj = getAdjacentNodes(itr->second);
+						for(typename Neighbours::const_iterator a = adj.begin(); a != adj.end(); a++)
+						{
+							if(!visited[a->first->getLabel()] && a->second < min_dist)
+							{
+								min_dist = a->second;
+								curr = make_pair(itr->first, a->first->getLabel());
+							}
+						}
+					}
+				}
+				
+				if(min_dist == (int) INFINITY)
+				{
+					break;
+				}
+				
+				visited[curr.second] = true;
+				t.addEdge(curr.first, curr.second, min_dist);
+			}
+		}
+	}
+	else if(!isDirected())
+	{
+		// Minimum spanning forest, one tree per connected component
+		return kruskalMinimumSpanningTree();
+	}
+	
+	return t;
+}
+
+template <class T>
+vector<typename Graph<T>::FlatEdge> Graph<T>::kruskalForest(unsigned int num_trees) const
+{
+	vector<FlatEdge> edges = flatEdges();
+	vector<FlatEdge> res;
+	DenseDisjointSet s(indexed_vertices.size());
+	
+	parallelSort(edges.begin(), edges.end());
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); (e != edges.end()) && (s.numSets() > num_trees); e++)
+	{
+		// Self loops and edges closing a cycle are rejected here
+		if(s.join(e->src, e->dest))
+		{
+			res.push_back(*e);
+		}
+	}
+	
+	return res;
+}
+
+template <class T>
+Graph<T> Graph<T>::kruskalMinimumSpanningTree() const
+{
+	Graph<T> t(is_directed);
+	
+	if(isDirected())
+	{
+		return t;
+	}
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		t.addVertex(itr->first);
+	}
+	
+	vector<FlatEdge> forest = kruskalForest(1);
+	
+	for(typename vector<FlatEdge>::const_iterator e = forest.begin(); e != forest.end(); e++)
+	{
+		t.addEdge(indexed_vertices[e->src]->getLabel(), indexed_vertices[e->dest]->getLabel(), e->cost);
+	}
+	
+	return t;
+}
+
+template <class T>
+vector<vector<T> > Graph<T>::singleLinkageClusters(unsigned int k) const
+{
+	vector<vector<T> > res;
+	
+	if(isDirected() || k == 0)
+	{
+		return res;
+	}
+	
+	vector<FlatEdge> forest = kruskalForest(k);
+	DenseDisjointSet s(indexed_vertices.size());
+	
+	for(typename vector<FlatEdge>::const_iterator e = forest.begin(); e != forest.end(); e++)
+	{
+		s.join(e->src, e->dest);
+	}
+	
+	// Clusters are listed in the order of their smallest label
+	map<unsigned int, unsigned int> cluster_of_root;
+	
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	{
+		unsigned int root = s.find(itr->second->getIndex());
+		
+		if(cluster_of_root.find(root) == cluster_of_root.end())
+		{
+			cluster_of_root[root] = res.size();
+			res.push_back(vector<T>());
+		}
+		
+		res[cluster_of_root[root]].push_back(itr->first);
+	}
+	
+	return res;
+}
+
+template <class T>
+bool Graph<T>::mergeVertices(T first, T second, T new_label)
+{
+	Vertex * ft = findVertex(first);
+	Vertex * sd = findVertex(second);
+	Vertex * nw = findVertex(new_label);
+	
+	// One of the lables does not exist
+	if((ft == NULL) || (sd == NULL))
+	{
+		return false;
+	}
+	
+	// Cannot merge a vertex with itself
+	if(ft == sd)
+	{	
+		return false;
+	}
+	
+	// Node with same name already exists (and it does not match with one of the nodes being merged
+	if((nw != NULL) && (ft != nw) && (sd != nw))
+	{
+		return false;
+	}
+	
+	// Rename the vertex
+	assert(renameVertex(first, new_label));
+	
+	// Add outgoing edges from second vertex, its self loops become the self loops of the merged vertex
+	Neighbours out = getAdjacentNodes(sd);
+	
+	for(typename Neighbours::const_iterator a = out.begin(); a != out.end(); a++)
+	{
+		ft->addEdge((a->first == sd)? ft: a->first, a->second);
+	}
+
+	// Add incoming edges from second vertex, with the cost of every copy
+	Neighbours in = getReverseNodes(sd);
+	
+	for(typename Neighbours::const_iterator r = in.begin(); r != in.end(); r++)
+	{
+		if(r->first != sd)
+		{
+			r->first->addEdge(ft, r->second);
+		}
+	}
+
+	// Erase entry from the list of vertices
+	vertices.erase(second);
+	detachVertex(sd);
+	unindexVertex(sd);
+	connectivity_stale = true;
+	topological_order_stale = true;
+	reachability_stale = true;
+	hop_index_stale = true;
+	
+	// Delete the vertex
+	deleteVertex(sd);
+
+	return true;
+}
+
+template <class T>
+T Graph<T>::pickRandomVertex() const
+{
+	int rnd = rand() % vertices.size();
+	typename map<T, Graph<T>::Vertex *>::const_iterator it(vertices.begin());
+	advance(it, rnd);
+	
+	return it->first;
+}
+
+// The caller owns the edge, prefer the other form which fills in an edge of the caller's
+template <class T>
+Edge<T> * Graph<T>::pickRandomEdge() const
+{
+	if(vertices.empty())
+	{
+		return NULL;
+	}
+	
+	Edge<T> e(vertices.begin()->first, vertices.begin()->first, 0);
+	
+	return pickRandomEdge(e)? new Edge<T>(e): NULL;
+}
+
+// Returns false, leaving edge as it is, if no vertex with an outgoing edge was hit within 4 * |V| tries
+template <class T>
+bool Graph<T>::pickRandomEdge(Edge<T> &edge) const
+{
+	Vertex *hd;
+	int cnt = 0;
+	const int double_num_vertices = 4 * vertices.size();
+	
+	if(indexed_vertices.empty())
+	{
+		return false;
+	}
+	
+	do
+	{
+		hd = indexed_vertices[rand() % indexed_vertices.size()];
+		cnt ++;
+	} while((hd->adjacency().size() == 0) && (cnt < double_num_vertices));
+
+	// Adjacency list empty
+	if(hd->adjacency().size() == 0)
+	{
+		return false;
+	}
+		
+	int rnd = rand() % hd->adjacency().size();
+	typename Adjacency::const_iterator it(hd->adjacency().begin());
+	advance(it, rnd);
+	
+	edge = Edge<T>(hd->getLabel(), indexed_vertices[it->first]->getLabel(), it->second);
+	
+	return true;
+}
+
+template <class T>
+bool Graph<T>::byEndpoints(const FlatEdge &e1, const FlatEdge &e2)
+{
+	return (e1.src < e2.src) || ((e1.src == e2.src) && (e1.dest < e2.dest));
+}
+
+// Counting sort of the edges on their source, or on their destination if by_dest. The edges of v are first[v] .. first[v+1]-1 of res
+template <class T>
+void Graph<T>::bucketEdges(const vector<FlatEdge> &edges, unsigned int n, bool by_dest, vector<unsigned int> &first, vector<FlatEdge> &res)
+{
+	first.assign(n + 1, 0);
+	res.resize(edges.size());
+	
+	for(unsigned int i = 0; i < edges.size(); i++)
+	{
+		first[(by_dest? edges[i].dest: edges[i].src) + 1]++;
+	}
+	
+	for(unsigned int v = 0; v < n; v++)
+	{
+		first[v + 1] += first[v];
+	}
+	
+	vector<unsigned int> pos(first.begin(), first.end() - 1);
+	
+	for(unsigned int i = 0; i < edges.size(); i++)
+	{
+		res[pos[by_dest? edges[i].dest: edges[i].src]++] = edges[i];
+	}
+}
+
+template <class T>
+void Graph<T>::mergeParallelEdges(vector<FlatEdge> &edges, unsigned int n)
+{
+	if(edges.empty())
+	{
+		return;
+	}
+	
+	// Edges are expected with src < dest. Dense graphs are merged through a matrix, the others by sorting
+	if((unsigned long long) n * n <= 4ULL * edges.size() + 1024)
+	{
+		vector<int> weight((size_t) n * n, 0);
+		
+		for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
+		{
+			weight[(size_t) e->src * n + e->dest] += e->cost;
+		}
+		
+		edges.clear();
+		
+		for(unsigned int u = 0; u < n; u++)
+		{
+			for(unsigned int v = u + 1; v < n; v++)
+			{
+				if(weight[(size_t) u * n + v] != 0)
+				{
+					FlatEdge e;
+					
+					e.src = u;
+					e.dest = v;
+					e.cost = weight[(size_t) u * n + v];
+					
+					edges.push_back(e);
+				}
+			}
+		}
+		
+		return;
+	}
+	
+	sort(edges.begin(), edges.end(), byEndpoints);
+	
+	unsigned int last = 0;
+	
+	for(unsigned int i = 1; i < edges.size(); i++)
+	{
+		if((edges[i].src == edges[last].src) && (edges[i].dest == edges[last].dest))
+		{
+			edges[last].cost += edges[i].cost;
+		}
+		else
+		{
+			edges[++last] = edges[i];
+		}
+	}
+	
+	edges.resize(last + 1);
+}
+
+template <class T>
+void Graph<T>::contractEdges(const vector<FlatEdge> &edges, unsigned int n, unsigned int t, vector<FlatEdge> &res, Xoshiro256 &rng)
+{
+	DenseDisjointSet s(n);
+	vector<FlatEdge> candidates(edges);
+	vector<long long> prefix;
+	unsigned int rejected = candidates.size();
+	
+	// Random edges are picked with probability proportional to their multiplicity and contracted, until t super vertices remain
+	while(s.numSets() > t)
+	{
+		// Too many picks fell inside a super vertex, so those edges are dropped
+		if(rejected >= candidates.size())
+		{
+			unsigned int last = 0;
+			
+			for(unsigned int i = 0; i < candidates.size(); i++)
+			{
+				if(!s.connected(candidates[i].src, candidates[i].dest))
+				{
+					candidates[last++] = candidates[i];
+				}
+			}
+			
+			candidates.resize(last);
+			prefix.resize(last);
+			
+			for(unsigned int i = 0; i < last; i++)
+			{
+				prefix[i] = (i == 0? 0: prefix[i - 1]) + candidates[i].cost;
+			}
+			
+			rejected = 0;
+			
+			// Disconnected graph, nothing more can be contracted
+			if(candidates.empty())
+			{
+				break;
+			}
+		}
+		
+		long long r = rng.below(prefix.back());
+		const FlatEdge &e = candidates[upper_bound(prefix.begin(), prefix.end(), r) - prefix.begin()];
+		
+		if(!s.join(e.src, e.dest))
+		{
+			rejected++;
+		}
+	}
+	
+	// Super vertices are numbered 0 .. t-1 and the edges inside them are dropped
+	vector<int> label(n, -1);
+	vector<unsigned int> super_vertex(n);
+	unsigned int next = 0;
+	
+	for(unsigned int v = 0; v < n; v++)
+	{
+		unsigned int root = s.find(v);
+		
+		if(label[root] == -1)
+		{
+			label[root] = next++;
+		}
+		
+		super_vertex[v] = label[root];
+	}
 	
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	res.clear();
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
 	{
-		multiset<pair<Vertex *, int> > adj = itr->second->getAdjacentNodes();
+		unsigned int a = super_vertex[e->src], b = super_vertex[e->dest];
 		
-		for(typename multiset<pair<Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+		if(a != b)
 		{
-			res.push_back(new Edge<T>(itr->first, a->first->getLabel(), a->second));
+			FlatEdge c;
+			
+			c.src = min(a, b);
+			c.dest = max(a, b);
+			c.cost = e->cost;
+			
+			res.push_back(c);
 		}
 	}
-		
-	return res;
+	
+	mergeParallelEdges(res, next);
 }
 
 template <class T>
-vector<vector<T> > Graph<T>::getVerticesComponentwise() const
+int Graph<T>::kargerSteinCut(const vector<FlatEdge> &edges, unsigned int n, Xoshiro256 &rng)
 {
-	vector<vector<T> > res;
-	map<T, bool> visited;
-	
-	if(isDirected())	// Kosaraju's algorithm for finding Strongly Connected Components (SCCs) in a directed graph
+	// Small graphs are cut exactly, by trying every bipartition in Gray code order, with vertex n-1 fixed on one side
+	if(n <= KARGER_STEIN_EXACT)
 	{
-		stack<T> finished_vertices;
-		map<T, bool> visited;
+		int weight[KARGER_STEIN_EXACT][KARGER_STEIN_EXACT] = {{0}};
 		
-		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-		{
-			visited[itr->first] = false;
-		}
-		
-		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+		for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
 		{
-			if(!visited[itr->first])
-			{
-				findFinishOrder(itr->first, finished_vertices, visited);
-			}
+			weight[e->src][e->dest] += e->cost;
+			weight[e->dest][e->src] += e->cost;
 		}
 		
-		Graph<T> rev_graph = reverse();
-		
-		for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-		{
-			visited[itr->first] = false;
-		}
+		int best = INT_MAX, cut = 0;
+		unsigned int side = 0;
 		
-		while(!finished_vertices.empty())
+		for(unsigned int i = 1; i < (1u << (n - 1)); i++)
 		{
-			T curr = finished_vertices.top();
-			finished_vertices.pop();
+			// Vertex v changes its side, so its edges to its old side start crossing the cut and the others stop
+			unsigned int v = __builtin_ctz(i);
+			
+			side ^= (1u << v);
 			
-			if(!visited[curr])
+			for(unsigned int w = 0; w < n; w++)
 			{
-				vector<T> vlist = rev_graph.dfs(curr);
-				
-				for(int i = vlist.size() - 1; i >= 0; i--)
-				{
-					rev_graph.removeVertex(vlist[i]); // Done to avoid revisiting
-					visited[vlist[i]] = true;
-				}
-
-				res.push_back(vlist);
+				cut += (((side >> w) & 1) == ((side >> v) & 1)? -weight[v][w]: weight[v][w]);
 			}
+			
+			best = min(best, cut);
 		}
 		
-		return res;
+		return best;
 	}
 	
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	// Both the branches start from the same graph and contract it down to n / sqrt(2) vertices independently
+	const unsigned int t = (unsigned int) ceil(1 + n / sqrt(2.0));
+	int best = INT_MAX;
+	vector<FlatEdge> contracted;
+	
+	for(int branch = 0; branch < 2; branch++)
 	{
-		visited[itr->first] = false;
+		contractEdges(edges, n, t, contracted, rng);
+		best = min(best, kargerSteinCut(contracted, t, rng));
 	}
 	
-	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+	return best;
+}
+
+template <class T>
+int Graph<T>::minCut(double success_probability) const
+{
+	if(is_directed)
+	{
+		return -1;
+	}
+	
+	const unsigned int n = indexed_vertices.size();
+	
+	if(n < 2)
+	{
+		return 0;
+	}
+	
+	// Multigraph of the unweighted edges, parallel edges are kept as multiplicities
+	vector<FlatEdge> edges = flatEdges();
+	DenseDisjointSet s(n);
+	unsigned int last = 0;
+	
+	for(unsigned int i = 0; i < edges.size(); i++)
 	{
-		if(!visited[itr->first])
+		if(edges[i].src != edges[i].dest)
 		{
-			vector<T> vlist = dfs(itr->first);
+			edges[i].cost = 1;
+			s.join(edges[i].src, edges[i].dest);
+			edges[last++] = edges[i];
+		}
+	}
+	
+	edges.resize(last);
+	mergeParallelEdges(edges, n);
+	
+	// Disconnected
+	if(s.numSets() > 1)
+	{
+		return 0;
+	}
+	
+	// A single run finds a particular minimum cut with probability at least 1 / (log2(n) + 1)
+	if(success_probability >= 1)
+	{
+		success_probability = 1 - 1e-9;
+	}
+	
+	const double per_run = 1 / (log2((double) n) + 1);
+	const int rep = max((int) ceil(log(1 - success_probability) / log(1 - per_run)), 1);
+	
+	// The edges around any single vertex form a cut, so the best of them is where the search starts
+	vector<int> degree(n, 0);
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
+	{
+		degree[e->src] += e->cost;
+		degree[e->dest] += e->cost;
+	}
+	
+	atomic<int> best(*min_element(degree.begin(), degree.end()));
 	
-			for(int i = vlist.size() - 1; i >= 0; i--)
+	// Runs are spread over the workers, each run with a generator of its own seeded by the run number.
+	// A connected graph has no cut below 1, so nobody starts a new run once that is found. This is the only early stop:
+	// which runs are skipped depends on the timing, but only once the answer is 1, so the result is the same for any number
+	// of threads. Stopping at any other bound would make it depend on them
+	parallelFor(0, rep, [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t i = lo; (i < hi) && (best.load(memory_order_relaxed) > 1); i++)
+		{
+			Xoshiro256 rng(i);
+			int loc_min = kargerSteinCut(edges, n, rng);
+			int curr = best.load();
+			
+			while((loc_min < curr) && !best.compare_exchange_weak(curr, loc_min))
 			{
-				visited[vlist[i]] = true;
 			}
-	
-			res.push_back(vlist);
 		}
-	}
+	}, 1);
 	
-	return res;
+	return best.load();
 }
 
 template <class T>
-vector<Graph<T> *> Graph<T>::getConnectedComponents() const
+pair<int, pair<vector<T>, vector<T> > > Graph<T>::stoerWagnerMinCut() const
 {
-	vector<Graph<T> *> res;
-	vector<vector<T> > vertices_compwise = getVerticesComponentwise();
+	pair<vector<T>, vector<T> > partition;
 	
-	for(typename vector<vector<T> >::const_iterator i = vertices_compwise.begin(); i != vertices_compwise.end(); i++)
+	// Not defined for directed graphs and negative weights
+	if(is_directed || hasNegativeWeightedEdge())
 	{
-		Graph<T> *g = new Graph<T>(is_directed);
-		
-		for(typename vector<T>::const_iterator j = i->begin(); j != i->end(); j++)
+		return make_pair(-1, partition);
+	}
+	
+	const unsigned int n = indexed_vertices.size();
+	
+	if(n < 2)
+	{
+		partition.first = getVertices();
+		return make_pair(0, partition);
+	}
+	
+	// Weighted adjacency of the super vertices, parallel edges are summed and self loops dropped
+	vector<map<unsigned int, int> > adj(n);
+	vector<FlatEdge> edges = flatEdges();
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
+	{
+		if(e->src != e->dest)
 		{
-			g->addVertex(*j);
+			adj[e->src][e->dest] += e->cost;
+			adj[e->dest][e->src] += e->cost;
 		}
+	}
+	
+	vector<vector<unsigned int> > members(n);
+	vector<bool> active(n, true);
+	vector<int> key(n);
+	vector<bool> in_a(n);
+	vector<unsigned int> best_side;
+	int best = INT_MAX;
+	
+	for(unsigned int v = 0; v < n; v++)
+	{
+		members[v].push_back(v);
+	}
+	
+	for(unsigned int phase = n; phase > 1; phase--)
+	{
+		// Maximum adjacency ordering, with stale heap entries skipped when popped
+		priority_queue<pair<int, unsigned int> > pq;
+		unsigned int prev = n, last = n;
 		
-		for(typename vector<T>::const_iterator j = i->begin(); j != i->end(); j++)
+		for(unsigned int v = 0; v < n; v++)
 		{
-			multiset<pair<Vertex *, int> > adj = findVertex(*j)->getAdjacentNodes();
+			key[v] = 0;
+			in_a[v] = false;
 			
-			for(typename multiset<pair<Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
+			if(active[v])
 			{
-				// Graph::addEdge() is intentionally not called here
-				Vertex *src = g->findVertex(*j);
-				Vertex *dest = g->findVertex(a->first->getLabel());
-				
-				if(src != NULL && dest != NULL)
-				{
-					src->addEdge(dest, a->second);
-				}
+				pq.push(make_pair(0, v));
 			}
 		}
 		
-		res.push_back(g);
-	}
-	
-	return res;
-}
-
-template <class T>
-Graph<T> Graph<T>::minimumSpanningTree() const
-{
-	Graph<T> t(is_directed);
-	
-	if(!isDirected() && isConnected())
-	{
-		if(vertices.size() != 0)
+		for(unsigned int added = 0; added < phase; )
 		{
-			map<T, bool> visited;
+			pair<int, unsigned int> top = pq.top();
+			pq.pop();
 			
-			for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
+			if(in_a[top.second] || top.first != key[top.second])
 			{
-				visited[itr->first] = false;
-				t.addVertex(itr->first);
+				continue;
 			}
 			
-			visited[vertices.begin()->first] = true;
-
-			while(1)
+			in_a[top.second] = true;
+			prev = last;
+			last = top.second;
+			added++;
+			
+			for(map<unsigned int, int>::const_iterator w = adj[last].begin(); w != adj[last].end(); w++)
 			{
-				int min_dist = (int) INFINITY;
-				pair<T, T> curr;
-				
-				for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
-				{
-					if(visited[itr->first])
-					{
-						multiset<pair<Vertex *, int> > adj = itr->second->getAdjacentNodes();
-						for(typename multiset<pair<Vertex *, int> >::const_iterator a = adj.begin(); a != adj.end(); a++)
-						{
-							if(!visited[a->first->getLabel()] && a->second < min_dist)
-							{
-								min_dist = a->second;
-								curr = make_pair(itr->first, a->first->getLabel());
-							}
-						}
-					}
-				}
-				
-				if(min_dist == (int) INFINITY)
+				if(!in_a[w->first])
 				{
-					break;
+					key[w->first] += w->second;
+					pq.push(make_pair(key[w->first], w->first));
 				}
-				
-				visited[curr.second] = true;
-				t.addEdge(curr.first, curr.second, min_dist);
 			}
 		}
+		
+		// Cut of the phase separates the last vertex from the others
+		if(key[last] < best)
+		{
+			best = key[last];
+			best_side = members[last];
+		}
+		
+		// Merge the last vertex into the one added before it
+		for(map<unsigned int, int>::const_iterator w = adj[last].begin(); w != adj[last].end(); w++)
+		{
+			adj[w->first].erase(last);
+			
+			if(w->first != prev)
+			{
+				adj[prev][w->first] += w->second;
+				adj[w->first][prev] += w->second;
+			}
+		}
+		
+		adj[last].clear();
+		members[prev].insert(members[prev].end(), members[last].begin(), members[last].end());
+		members[last].clear();
+		active[last] = false;
 	}
 	
-	return t;
-}
-
-template <class T>
-bool Graph<T>::mergeVertices(T first, T second, T new_label)
-{
-	Vertex * ft = findVertex(first);
-	Vertex * sd = findVertex(second);
-	Vertex * nw = findVertex(new_label);
+	vector<bool> on_best_side(n, false);
 	
-	// One of the lables does not exist
-	if((ft == NULL) || (sd == NULL))
+	for(unsigned int i = 0; i < best_side.size(); i++)
 	{
-		return false;
-	}
-	
-	// Cannot merge a vertex with itself
-	if(ft == sd)
-	{	
-		return false;
+		on_best_side[best_side[i]] = true;
 	}
 	
-	// Node with same name already exists (and it does not match with one of the nodes being merged
-	if((nw != NULL) && (ft != nw) && (sd != nw))
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
 	{
-		return false;
+		if(on_best_side[itr->second->getIndex()])
+		{
+			partition.first.push_back(itr->first);
+		}
+		else
+		{
+			partition.second.push_back(itr->first);
+		}
 	}
 	
-	// Rename the vertex
-	assert(renameVertex(first, new_label));
-	
-	// Add outgoing edges from second vertex
-	ft->addEdgesInBatch(sd->getAdjacentNodes());
-
-	// Add incoming edges from second vertex
-	sd->addIncomingEdges(ft);
-
-	// Erase entry from the list of vertices
-	vertices.erase(second);
-	
-	// Delete the vertex
-	delete sd;
-
-	return true;
-}
-
-template <class T>
-T Graph<T>::pickRandomVertex() const
-{
-	int rnd = rand() % vertices.size();
-	typename map<T, Graph<T>::Vertex *>::const_iterator it(vertices.begin());
-	advance(it, rnd);
-	
-	return it->first;
+	return make_pair(best, partition);
 }
 
 template <class T>
-Edge<T> * Graph<T>::pickRandomEdge() const
+pair<long long, pair<vector<T>, vector<T> > > Graph<T>::maxFlow(T source, T sink, MaxFlowAlgorithm algorithm) const
 {
-	Vertex *hd;
-	multiset<pair<Graph<T>::Vertex *, int> > adj;
-	int cnt = 0;
-	const int double_num_vertices = 4 * vertices.size();
+	pair<vector<T>, vector<T> > partition;
+	Vertex *s = findVertex(source);
+	Vertex *t = findVertex(sink);
 	
-	do
+	// Edge costs are the capacities, so they cannot be negative
+	if(s == NULL || t == NULL || s == t || hasNegativeWeightedEdge())
 	{
-		hd = findVertex(pickRandomVertex());
-		adj = hd->getAdjacentNodes();
-		cnt ++;
-	} while((adj.size() == 0) && (cnt < double_num_vertices));
-
-	// Adjacency list empty
-	if(adj.size() == 0)
+		return make_pair(-1LL, partition);
+	}
+	
+	// The residual network is built once, an undirected edge has its capacity in both the directions
+	FlowNetwork net(indexed_vertices.size());
+	vector<FlatEdge> edges = flatEdges();
+	
+	for(typename vector<FlatEdge>::const_iterator e = edges.begin(); e != edges.end(); e++)
 	{
-		return NULL;
+		if(e->src != e->dest)
+		{
+			net.addEdge(e->src, e->dest, e->cost, is_directed? 0: e->cost);
+		}
 	}
-		
-	int rnd = rand() % adj.size();
-	typename multiset<pair<Graph<T>::Vertex *, int> >::const_iterator it(adj.begin());
-	advance(it, rnd);
 	
-	Vertex *tl = it->first;
+	net.build();
 	
-	return new Edge<T>(hd->getLabel(), tl->getLabel(), it->second);
-}
-
-template <class T>
-int Graph<T>::minCut() const
-{
-	if(is_directed)
+	long long flow;
+	
+	if(algorithm == PUSH_RELABEL)
 	{
-		return -1;
+		flow = net.pushRelabel(s->getIndex(), t->getIndex());
+	}
+	else
+	{
+		flow = net.dinic(s->getIndex(), t->getIndex());
 	}
 	
-	int rep = 2000;
-	int min = vertices.size() + 2;
+	// Minimum cut, the source side holds the vertices that cannot reach the sink in the residual network
+	vector<bool> source_side = net.sourceSide(t->getIndex());
 	
-	for(int i = 0; i < rep; i++)
+	for(typename map<T, Vertex *>::const_iterator itr = vertices.begin(); itr != vertices.end(); itr++)
 	{
-		Graph<T> g = *this;
-		
-		srand(i);
-
-		g.removeSelfLoops();
-
-		while(g.vertices.size() > 2)
-		{		
-			Edge<T> * rn = g.pickRandomEdge();
-			
-			if(rn == NULL)
-			{
-				break;
-			}
-			
-			g.mergeVertices(rn->src, rn->dest, rn->src);
-			g.removeSelfLoops();
+		if(source_side[itr->second->getIndex()])
+		{
+			partition.first.push_back(itr->first);
 		}
-
-		if(g.vertices.size() == 2)
+		else
 		{
-			int loc_min = g.vertices.begin()->second->getAdjacentNodes().size();
-			
-			if(loc_min < min)
-			{
-				min = loc_min;
-			}
-		}	
+			partition.second.push_back(itr->first);
+		}
 	}
 	
-	return min;
+	return make_pair(flow, partition);
 }
 
 #endif
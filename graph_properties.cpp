@@ -463,6 +463,39 @@ int main()
 	cout << g30 << endl;
 	cout << g31 << endl;
 	cout << g32 << endl;
+	
+	// Multigraph with self loops and parallel edges
+	Graph<int> m(false);
+	vector<int> self_loops;
+	vector<pair<int, int> > parallel_edges;
+	
+	for(int i = 1; i <= 4; i++)
+	{
+		m.addVertex(i);
+	}
+	
+	m.addEdge(1, 2, 3);
+	m.addEdge(2, 1, 1);
+	m.addEdge(2, 3, 2);
+	m.addEdge(3, 3, 1);
+	m.addEdge(3, 4, 2);
+	m.addEdge(4, 3, 2);
+	m.addEdge(4, 3, 5);
+	
+	cout << "Simple: " << m.isSimple(self_loops, parallel_edges) << endl;
+	
+	for(unsigned int i = 0; i < self_loops.size(); i++)
+	{
+		cout << "Self loop at " << self_loops[i] << endl;
+	}
+	
+	for(unsigned int i = 0; i < parallel_edges.size(); i++)
+	{
+		cout << "Parallel edges between " << parallel_edges[i].first << " and " << parallel_edges[i].second << endl;
+	}
+	
+	cout << "Edges removed by simplify(): " << m.simplify() << endl;
+	cout << m << endl;
 
 	return 0;
 }
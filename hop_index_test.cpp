@@ -0,0 +1,163 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#include "graph.h"
+
+using namespace std;
+
+// Random graph, compared against the breadth first search without the index
+unsigned int countMismatches(bool directed, int n, int m, int seed)
+{
+	Graph<int> indexed(directed), plain(directed);
+	unsigned int mismatches = 0;
+	
+	srand(seed);
+	indexed.enableHopIndex();
+	
+	for(int i = 0; i < n; i++)
+	{
+		indexed.addVertex(i);
+		plain.addVertex(i);
+	}
+	
+	for(int i = 0; i < m; i++)
+	{
+		int u = rand() % n, v = rand() % n;
+		
+		indexed.addEdge(u, v);
+		plain.addEdge(u, v);
+	}
+	
+	for(int u = 0; u < n; u++)
+	{
+		for(int v = 0; v < n; v++)
+		{
+			if(indexed.hop_distance(u, v) != plain.hop_distance(u, v))
+			{
+				mismatches++;
+			}
+		}
+	}
+	
+	return mismatches;
+}
+
+int main()
+{
+	Graph<char> g(false);
+	
+	for(char c = 'a'; c <= 'g'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('a', 'b');
+	g.addEdge('b', 'c');
+	g.addEdge('c', 'd');
+	g.addEdge('d', 'e');
+	g.addEdge('a', 'f');
+	g.addEdge('f', 'd');
+	
+	g.enableHopIndex();
+	
+	cout << "a to e: " << g.hop_distance('a', 'e') << endl;
+	cout << "c to f: " << g.hop_distance('c', 'f') << endl;
+	cout << "a to g: " << g.hop_distance('a', 'g') << endl;
+	
+	g.addEdge('e', 'g');
+	
+	cout << "a to g after adding e - g: " << g.hop_distance('a', 'g') << endl;
+	
+	// The saved index is loaded by the labels of the vertices, whatever their order in the other graph
+	stringstream saved;
+	Graph<char> h(false);
+	
+	g.saveHopIndex(saved);
+	
+	for(char c = 'g'; c >= 'a'; c--)
+	{
+		h.addVertex(c);
+	}
+	
+	cout << "Loaded: " << h.loadHopIndex(saved) << ", b to g: " << h.hop_distance('b', 'g') << endl;
+	
+	// Not into a directed graph with the same labels
+	stringstream saved_again;
+	Graph<char> d(true);
+	
+	g.saveHopIndex(saved_again);
+	
+	for(char c = 'a'; c <= 'g'; c++)
+	{
+		d.addVertex(c);
+	}
+	
+	cout << "Loaded into a directed graph: " << d.loadHopIndex(saved_again) << endl;
+	
+	cout << "Undirected mismatches: " << countMismatches(false, 120, 150, 1) << endl;
+	cout << "Directed mismatches: " << countMismatches(true, 120, 300, 2) << endl;
+	
+	// Concurrent queries, once the labels are built
+	Graph<int> c(false);
+	const int n = 2000, num_threads = 4;
+	atomic<unsigned int> mismatches(0);
+	vector<thread> pool;
+	
+	for(int i = 0; i < n; i++)
+	{
+		c.addVertex(i);
+	}
+	
+	for(int i = 0; i < n; i++)
+	{
+		c.addEdge(i, (i + 1) % n);
+	}
+	
+	c.enableHopIndex();
+	c.hop_distance(0, 0);
+	
+	for(int t = 0; t < num_threads; t++)
+	{
+		pool.push_back(thread([&, t]()
+		{
+			for(int i = t; i < n; i += num_threads)
+			{
+				if(c.hop_distance(0, i) != min(i, n - i))
+				{
+					mismatches++;
+				}
+			}
+		}));
+	}
+	
+	for(int t = 0; t < num_threads; t++)
+	{
+		pool[t].join();
+	}
+	
+	cout << "Concurrent mismatches: " << mismatches << endl;
+	
+	return 0;
+}
@@ -0,0 +1,301 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _HOP_LABEL_INDEX_H
+#define _HOP_LABEL_INDEX_H
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+/**
+	Exact hop distances between the vertices 0 .. n-1 of a graph, by pruned landmark labeling (Akiba, Iwata and Yoshida).
+
+	Every vertex keeps the hops to (out label) and from (in label) some hubs. The vertices become hubs in the
+	descending order of their degrees, and each runs a breadth first search which stops wherever the labels
+	built so far already give the distance. The distance from u to v is then the smallest sum over the hubs
+	common to the out label of u and the in label of v, both kept sorted by the hub. On an undirected graph
+	the two labels are the same and only one is kept. Queries only read the labels.
+**/
+class HopLabelIndex
+{
+	private:
+		typedef vector<pair<unsigned int, unsigned int> > Label;	// (Rank of the hub, hops), sorted by the rank
+		
+		bool directed;
+		vector<Label> out_labels;
+		vector<Label> in_labels;	// Empty when undirected
+		
+		const Label &inLabel(unsigned int v) const
+		{
+			return directed? in_labels[v]: out_labels[v];
+		}
+		
+		static unsigned int intersect(const Label &from, const Label &to)
+		{
+			unsigned int best = UINT_MAX;
+			
+			for(unsigned int i = 0, j = 0; i < from.size() && j < to.size(); )
+			{
+				if(from[i].first == to[j].first)
+				{
+					best = min(best, from[i].second + to[j].second);
+					i++;
+					j++;
+				}
+				else if(from[i].first < to[j].first)
+				{
+					i++;
+				}
+				else
+				{
+					j++;
+				}
+			}
+			
+			return best;
+		}
+		
+		// Breadth first search from the hub over adj, labelling the vertices reached in target.
+		// hub_hops holds the hops of the hub to (or from) the earlier hubs, from its opposite label
+		void prunedSearch(unsigned int hub, unsigned int rank, const vector<unsigned int> &first, const vector<unsigned int> &adj,
+			vector<Label> &target, const vector<Label> &opposite, vector<unsigned int> &hub_hops, vector<unsigned int> &hops)
+		{
+			const Label &hub_label = opposite[hub];
+			vector<unsigned int> queue(1, hub);
+			
+			for(unsigned int i = 0; i < hub_label.size(); i++)
+			{
+				hub_hops[hub_label[i].first] = hub_label[i].second;
+			}
+			
+			hops[hub] = 0;
+			
+			for(unsigned int head = 0; head < queue.size(); head++)
+			{
+				unsigned int v = queue[head];
+				const Label &label = target[v];
+				bool pruned = false;
+				
+				// Some earlier hub already gives the distance
+				for(unsigned int i = 0; i < label.size() && !pruned; i++)
+				{
+					pruned = (hub_hops[label[i].first] != UINT_MAX) && (hub_hops[label[i].first] + label[i].second <= hops[v]);
+				}
+				
+				if(pruned)
+				{
+					continue;
+				}
+				
+				target[v].push_back(make_pair(rank, hops[v]));
+				
+				for(unsigned int a = first[v]; a < first[v + 1]; a++)
+				{
+					if(hops[adj[a]] == UINT_MAX)
+					{
+						hops[adj[a]] = hops[v] + 1;
+						queue.push_back(adj[a]);
+					}
+				}
+			}
+			
+			for(unsigned int i = 0; i < queue.size(); i++)
+			{
+				hops[queue[i]] = UINT_MAX;
+			}
+			
+			for(unsigned int i = 0; i < hub_label.size(); i++)
+			{
+				hub_hops[hub_label[i].first] = UINT_MAX;
+			}
+		}
+		
+		static void toCsr(unsigned int n, const vector<pair<unsigned int, unsigned int> > &edges, bool reversed, vector<unsigned int> &first, vector<unsigned int> &adj)
+		{
+			first.assign(n + 1, 0);
+			adj.resize(edges.size());
+			
+			for(unsigned int i = 0; i < edges.size(); i++)
+			{
+				first[(reversed? edges[i].second: edges[i].first) + 1]++;
+			}
+			
+			for(unsigned int v = 0; v < n; v++)
+			{
+				first[v + 1] += first[v];
+			}
+			
+			vector<unsigned int> pos(first.begin(), first.end() - 1);
+			
+			for(unsigned int i = 0; i < edges.size(); i++)
+			{
+				unsigned int src = reversed? edges[i].second: edges[i].first;
+				
+				adj[pos[src]++] = reversed? edges[i].first: edges[i].second;
+			}
+		}
+		
+	public:
+		HopLabelIndex() : directed(false)
+		{
+		}
+		
+		// Undirected edges are to be given in both the directions
+		void build(unsigned int n, const vector<pair<unsigned int, unsigned int> > &edges, bool directed)
+		{
+			vector<unsigned int> out_first, out_adj, in_first, in_adj;
+			vector<unsigned int> by_degree(n);
+			vector<unsigned int> hub_hops(n, UINT_MAX), hops(n, UINT_MAX);
+			
+			this->directed = directed;
+			out_labels.assign(n, Label());
+			in_labels.assign(directed? n: 0, Label());
+			
+			toCsr(n, edges, false, out_first, out_adj);
+			
+			if(directed)
+			{
+				toCsr(n, edges, true, in_first, in_adj);
+			}
+			
+			// Vertices of high degree are hubs first, they cover the most shortest paths
+			for(unsigned int v = 0; v < n; v++)
+			{
+				by_degree[v] = v;
+			}
+			
+			vector<pair<unsigned int, unsigned int> > key(n);
+			
+			for(unsigned int v = 0; v < n; v++)
+			{
+				unsigned int degree = out_first[v + 1] - out_first[v] + (directed? in_first[v + 1] - in_first[v]: 0);
+				
+				key[v] = make_pair(UINT_MAX - degree, v);
+			}
+			
+			sort(key.begin(), key.end());
+			
+			for(unsigned int rank = 0; rank < n; rank++)
+			{
+				unsigned int hub = key[rank].second;
+				
+				if(directed)
+				{
+					prunedSearch(hub, rank, out_first, out_adj, in_labels, out_labels, hub_hops, hops);
+					prunedSearch(hub, rank, in_first, in_adj, out_labels, in_labels, hub_hops, hops);
+				}
+				else
+				{
+					prunedSearch(hub, rank, out_first, out_adj, out_labels, out_labels, hub_hops, hops);
+				}
+			}
+		}
+		
+		// UINT_MAX if v cannot be reached from u
+		unsigned int distance(unsigned int u, unsigned int v) const
+		{
+			if(u == v)
+			{
+				return 0;
+			}
+			
+			return intersect(out_labels[u], inLabel(v));
+		}
+		
+		// Plain text: the kind of graph, the number of vertices and then the labels, one per line
+		void save(ostream &out) const
+		{
+			out << directed << " " << out_labels.size() << endl;
+			
+			for(unsigned int k = 0; k < (directed? 2u: 1u); k++)
+			{
+				const vector<Label> &labels = (k == 0)? out_labels: in_labels;
+				
+				for(unsigned int v = 0; v < labels.size(); v++)
+				{
+					out << labels[v].size();
+					
+					for(unsigned int i = 0; i < labels[v].size(); i++)
+					{
+						out << " " << labels[v][i].first << " " << labels[v][i].second;
+					}
+					
+					out << endl;
+				}
+			}
+		}
+		
+		// The labels of the saved vertex i are loaded as those of position[i]. Returns false on malformed input
+		bool load(istream &in, const vector<unsigned int> &position)
+		{
+			unsigned int n;
+			
+			if(!(in >> directed >> n) || n != position.size())
+			{
+				return false;
+			}
+			
+			out_labels.assign(n, Label());
+			in_labels.assign(directed? n: 0, Label());
+			
+			for(unsigned int k = 0; k < (directed? 2u: 1u); k++)
+			{
+				vector<Label> &labels = (k == 0)? out_labels: in_labels;
+				
+				for(unsigned int v = 0; v < n; v++)
+				{
+					unsigned int size;
+					Label &label = labels[position[v]];
+					
+					if(!(in >> size))
+					{
+						return false;
+					}
+					
+					label.resize(size);
+					
+					for(unsigned int i = 0; i < size; i++)
+					{
+						if(!(in >> label[i].first >> label[i].second))
+						{
+							return false;
+						}
+					}
+				}
+			}
+			
+			return true;
+		}
+		
+		unsigned int numElements() const
+		{
+			return out_labels.size();
+		}
+		
+		bool isDirected() const
+		{
+			return directed;
+		}
+};
+
+#endif
@@ -0,0 +1,134 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <cstdlib>
+#include <iostream>
+#include <stdint.h>
+
+#include "graph.h"
+
+using namespace std;
+
+int main()
+{
+	Graph<char> g(true);
+	
+	for(char c = 'a'; c <= 'd'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('a', 'b', 4);
+	g.addEdge('b', 'c', 2);
+	g.addEdge('c', 'a', 7);
+	g.addEdge('a', 'd', 1);
+	
+	pair<vector<char>, DenseMatrix<int> > m = g.flatAdjacencyMatrix();
+	const int no_edge = (int) INFINITY;
+	
+	cout << "Adjacency matrix (- for no edge):" << endl;
+	for(unsigned int i = 0; i < m.first.size(); i++)
+	{
+		cout << m.first[i] << ": ";
+		
+		for(unsigned int j = 0; j < m.first.size(); j++)
+		{
+			if(m.second(i, j) == no_edge)
+			{
+				cout << "- ";
+			}
+			else
+			{
+				cout << m.second(i, j) << " ";
+			}
+		}
+		
+		cout << endl;
+	}
+	
+	cout << "Aligned: " << ((uintptr_t) m.second.data() % MATRIX_ALIGNMENT == 0) << endl;
+	
+	// Into memory of the caller
+	uint64_t bits[4 * 1];
+	vector<char> labels = g.connectivityList(bits);
+	
+	cout << "Connectivity rows as words:";
+	for(unsigned int i = 0; i < labels.size(); i++)
+	{
+		cout << " " << labels[i] << "=" << bits[i];
+	}
+	cout << endl;
+	
+	g.addEdge('a', 'b', 5);
+	
+	cout << "Labels after adding a parallel edge: " << g.adjacencyMatrix(m.second.data()).size() << endl;
+	
+	// Random simple graphs, in both the directions, against the cell by cell lookups
+	for(int directed = 0; directed <= 1; directed++)
+	{
+		Graph<int> r(directed);
+		const int n = 150;
+		unsigned int mismatches = 0, edges = 0;
+		
+		srand(3 + directed);
+		
+		for(int i = 0; i < n; i++)
+		{
+			r.addVertex(i);
+		}
+		
+		for(int i = 0; i < 4 * n; i++)
+		{
+			int u = rand() % n, v = rand() % n;
+			
+			if(u != v && !r.edgeExists(u, v))
+			{
+				r.addEdge(u, v, rand() % 100 - 20);
+			}
+		}
+		
+		pair<vector<int>, vector<vector<int> > > costs = r.adjacencyMatrix();
+		pair<vector<int>, BitMatrix> connected = r.connectivityBits();
+		vector<int> caller(n * n);
+		
+		r.adjacencyMatrix(&caller[0]);
+		
+		for(int i = 0; i < n; i++)
+		{
+			for(int j = 0; j < n; j++)
+			{
+				int u = costs.first[i], v = costs.first[j];
+				vector<int> w = r.edgeCosts(u, v);
+				bool exists = !w.empty();
+				int expected = (u == v)? 0: (exists? w[0]: no_edge);
+				
+				edges += exists;
+				
+				if(costs.second[i][j] != expected || caller[i * n + j] != expected || connected.second.get(i, j) != ((u == v) || exists))
+				{
+					mismatches++;
+				}
+			}
+		}
+		
+		cout << (directed? "Directed": "Undirected") << " random graph: " << edges << " edge cells, " << mismatches << " mismatch(es)" << endl;
+	}
+	
+	return 0;
+}
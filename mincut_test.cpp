@@ -44,6 +44,76 @@ int main()
 	cout << g << endl;
 	
 	cout << g.minCut() << endl;
+	
+	// Two complete graphs on 10 vertices, joined by 3 edges
+	Graph<int> h(false);
+	
+	for(int i = 0; i < 20; i++)
+	{
+		h.addVertex(i);
+	}
+	
+	for(int i = 0; i < 10; i++)
+	{
+		for(int j = i + 1; j < 10; j++)
+		{
+			h.addEdge(i, j);
+			h.addEdge(10 + i, 10 + j);
+		}
+	}
+	
+	h.addEdge(0, 10);
+	h.addEdge(1, 11);
+	h.addEdge(2, 10);
+	
+	cout << "Min-cut of the joined cliques: " << h.minCut() << endl;
+	cout << "Min-cut with 0.5 success probability: " << h.minCut(0.5) << endl;
+	
+	h.removeEdge(0, 10);
+	h.removeEdge(1, 11);
+	h.removeEdge(2, 10);
+	
+	cout << "Min-cut of the separated cliques: " << h.minCut() << endl;
+	
+	// Weighted example from the paper of Stoer and Wagner
+	Graph<int> w(false);
+	
+	for(int i = 1; i <= 8; i++)
+	{
+		w.addVertex(i);
+	}
+	
+	w.addEdge(1, 2, 2);
+	w.addEdge(1, 5, 3);
+	w.addEdge(2, 3, 3);
+	w.addEdge(2, 5, 2);
+	w.addEdge(2, 6, 2);
+	w.addEdge(3, 4, 4);
+	w.addEdge(3, 7, 2);
+	w.addEdge(4, 7, 2);
+	w.addEdge(4, 8, 2);
+	w.addEdge(5, 6, 3);
+	w.addEdge(6, 7, 1);
+	w.addEdge(7, 8, 3);
+	
+	pair<int, pair<vector<int>, vector<int> > > cut = w.stoerWagnerMinCut();
+	
+	cout << "Stoer-Wagner min-cut: " << cut.first << endl << "{ ";
+	
+	for(int i = 0; i < cut.second.first.size(); i++)
+	{
+		cout << cut.second.first[i] << " ";
+	}
+	
+	cout << "} { ";
+	
+	for(int i = 0; i < cut.second.second.size(); i++)
+	{
+		cout << cut.second.second[i] << " ";
+	}
+	
+	cout << "}" << endl;
+	cout << "Stoer-Wagner min-cut of the separated cliques: " << h.stoerWagnerMinCut().first << endl;
 /*	g.mergeVertices(8, 4, 8);
 	g.removeSelfLoops();
 	cout << g << endl;
@@ -0,0 +1,119 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+
+using namespace std;
+
+void describe(const char *name, const Graph<int> &g)
+{
+	cout << name << ": " << g.numVertices() << " vertices, " << g.numEdges() << " edges" << endl;
+}
+
+Graph<int> chain(int n)
+{
+	Graph<int> g(true);
+	
+	for(int i = 0; i < n; i++)
+	{
+		g.addVertex(i);
+	}
+	
+	for(int i = 0; i + 1 < n; i++)
+	{
+		g.addEdge(i, i + 1, i);
+	}
+	
+	return g;
+}
+
+int main()
+{
+	Graph<int> a = chain(5);
+	Graph<int> b(a);
+	
+	b.addEdge(4, 0);
+	
+	describe("Original", a);
+	describe("Copy with one more edge", b);
+	cout << "Copy is cyclic, original is not: " << !b.isAcyclic() << ", " << a.isAcyclic() << endl;
+	
+	// Assignment replaces the contents, rather than adding to them
+	Graph<int> c = chain(3);
+	
+	c = a;
+	describe("Assigned", c);
+	
+	c = c;
+	describe("Assigned to itself", c);
+	
+	Graph<int> d(std::move(c));
+	
+	describe("Moved", d);
+	describe("Moved from", c);
+	
+	c.addVertex(7);
+	c = std::move(b);
+	describe("Move assigned", c);
+	cout << "Path 4 -> 0 after the move: " << c.pathExists(4, 0) << endl;
+	
+	swap(a, c);
+	describe("Swapped", a);
+	describe("Swapped with", c);
+	
+	// The indexes travel with the vertices and copies answer from their own
+	Graph<int> e = chain(6);
+	
+	e.enableReachabilityIndex();
+	e.enableTopologicalOrder();
+	
+	Graph<int> f(e);
+	
+	cout << "The copy refuses 5 -> 0 while it keeps the order: " << !f.addEdge(5, 0) << endl;
+	
+	f.disableTopologicalOrder();
+	f.addEdge(5, 0);
+	
+	cout << "Path 5 -> 0 in the copy and the original: " << f.pathExists(5, 0) << ", " << e.pathExists(5, 0) << endl;
+	
+	vector<int> order = e.topologicalOrder();
+	
+	cout << "Topological order kept by the original:";
+	for(unsigned int i = 0; i < order.size(); i++)
+	{
+		cout << " " << order[i];
+	}
+	cout << endl;
+	
+	// Growing a vector moves the graphs instead of copying them
+	vector<Graph<int> > stages;
+	
+	for(int i = 1; i <= 4; i++)
+	{
+		stages.push_back(chain(i));
+	}
+	
+	describe("Last stage", stages.back());
+	
+	return 0;
+}
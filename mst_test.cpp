@@ -0,0 +1,159 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "graph.h"
+
+using namespace std;
+
+// Counts the comparisons made on the thread which started the sort
+struct CountingLess
+{
+	thread::id caller;
+	atomic<unsigned long> *on_caller;
+	
+	bool operator()(int a, int b) const
+	{
+		if(this_thread::get_id() == caller)
+		{
+			(*on_caller)++;
+		}
+		
+		return a < b;
+	}
+};
+
+int weight(Graph<int> &g)
+{
+	int total = 0;
+	vector<Edge<int> *> edges = g.getEdges();
+	
+	for(int i = 0; i < edges.size(); i++)
+	{
+		total += edges[i]->cost;
+		delete edges[i];
+	}
+	
+	return total / 2;
+}
+
+int main()
+{
+	Graph<char> g(false);
+	
+	for(char c = 'a'; c <= 'i'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	// First component
+	g.addEdge('a', 'b', 4);
+	g.addEdge('a', 'c', 8);
+	g.addEdge('b', 'c', 11);
+	g.addEdge('b', 'd', 8);
+	g.addEdge('c', 'e', 7);
+	g.addEdge('d', 'e', 2);
+	g.addEdge('c', 'c', 1);
+	
+	// Second component
+	g.addEdge('f', 'g', 9);
+	g.addEdge('g', 'h', 14);
+	g.addEdge('f', 'h', 10);
+	
+	// 'i' is isolated
+	
+	cout << g << endl;
+	
+	Graph<char> forest = g.kruskalMinimumSpanningTree();
+	cout << "Kruskal's minimum spanning forest: " << endl << forest << endl;
+	
+	Graph<char> tree = g.minimumSpanningTree();
+	cout << "Minimum spanning tree: " << endl << tree << endl;
+	
+	for(unsigned int k = 1; k <= 5; k++)
+	{
+		vector<vector<char> > clusters = g.singleLinkageClusters(k);
+		
+		cout << k << " cluster(s): ";
+		
+		for(int i = 0; i < clusters.size(); i++)
+		{
+			cout << "{ ";
+			
+			for(int j = 0; j < clusters[i].size(); j++)
+			{
+				cout << clusters[i][j] << " ";
+			}
+			
+			cout << "} ";
+		}
+		
+		cout << endl;
+	}
+	
+	// Prim and Kruskal must agree on the weight of a larger connected graph
+	Graph<int> big(false);
+	const int n = 2000;
+	
+	srand(7);
+	
+	for(int i = 0; i < n; i++)
+	{
+		big.addVertex(i);
+	}
+	
+	for(int i = 1; i < n; i++)
+	{
+		big.addEdge(i, rand() % i, rand() % 1000);
+	}
+	
+	for(int i = 0; i < 20 * n; i++)
+	{
+		big.addEdge(rand() % n, rand() % n, rand() % 1000);
+	}
+	
+	Graph<int> prim = big.minimumSpanningTree();
+	Graph<int> kruskal = big.kruskalMinimumSpanningTree();
+	
+	cout << "Prim: " << prim.numEdges() << " edges, weight " << weight(prim) << endl;
+	cout << "Kruskal: " << kruskal.numEdges() << " edges, weight " << weight(kruskal) << endl;
+	
+	// The edges are sorted by parallelSort, whose chunks must be sorted on the worker threads and not on the caller
+	vector<int> values(200000);
+	atomic<unsigned long> on_caller(0);
+	CountingLess counting_less = { this_thread::get_id(), &on_caller };
+	
+	for(unsigned int i = 0; i < values.size(); i++)
+	{
+		values[i] = rand();
+	}
+	
+	parallelSort(values.begin(), values.end(), counting_less);
+	
+	cout << "Sorted: " << (is_sorted(values.begin(), values.end())? "yes": "no") << ", chunks left to the calling thread: " << ((numWorkers(values.size()) <= 1 || on_caller == 0)? "none": "some") << endl;
+	
+	return 0;
+}
@@ -0,0 +1,209 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#ifndef _NODE_POOL_H
+#define _NODE_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+#define NODE_POOL_CHUNK 65536	// Bytes taken from the system at a time
+#define NODE_POOL_GRANULARITY 16	// Sizes of the blocks are rounded up to this, which is also their alignment
+#define NODE_POOL_MAX_BLOCK 512	// Larger blocks are not pooled
+
+/**
+	Memory for many small objects of a few sizes, like the vertices and the tree nodes of the adjacency sets.
+
+	Blocks are carved one after another out of large chunks, a freed block is kept on the free list of its size
+	and handed out again before any new space is carved. The chunks are returned to the system only when the pool
+	is destroyed, all at once, so the objects in it need not be freed one by one if they are no longer needed.
+	Any number of threads can allocate and free blocks together, one at a time under a lock.
+**/
+class NodePool
+{
+	private:
+		struct FreeBlock
+		{
+			FreeBlock *next;
+		};
+		
+		vector<char *> chunks;
+		vector<FreeBlock *> free_lists;	// One per size class
+		char *next_block, *chunk_end;
+		size_t chunk_size;
+		mutex lock;
+		
+		static size_t sizeClass(size_t bytes)
+		{
+			return (bytes + NODE_POOL_GRANULARITY - 1) / NODE_POOL_GRANULARITY - 1;
+		}
+		
+		NodePool(const NodePool &);
+		NodePool & operator=(const NodePool &);
+		
+	public:
+		NodePool(size_t chunk_size = NODE_POOL_CHUNK)
+			: free_lists(sizeClass(NODE_POOL_MAX_BLOCK) + 1, (FreeBlock *) NULL), next_block(NULL), chunk_end(NULL), chunk_size(chunk_size)
+		{
+		}
+		
+		~NodePool()
+		{
+			for(unsigned int i = 0; i < chunks.size(); i++)
+			{
+				::operator delete(chunks[i]);
+			}
+		}
+		
+		void *allocate(size_t bytes)
+		{
+			if(bytes > NODE_POOL_MAX_BLOCK)
+			{
+				return ::operator new(bytes);
+			}
+			
+			const size_t c = sizeClass(bytes);
+			lock_guard<mutex> guard(lock);
+			
+			if(free_lists[c] != NULL)
+			{
+				FreeBlock *block = free_lists[c];
+				
+				free_lists[c] = block->next;
+				
+				return block;
+			}
+			
+			const size_t rounded = (c + 1) * NODE_POOL_GRANULARITY;
+			
+			// The rest of the current chunk is given up, it is smaller than a block
+			if(next_block == NULL || (size_t) (chunk_end - next_block) < rounded)
+			{
+				chunks.push_back((char *) ::operator new(chunk_size));
+				next_block = chunks.back();
+				chunk_end = next_block + chunk_size;
+			}
+			
+			void *block = next_block;
+			
+			next_block += rounded;
+			
+			return block;
+		}
+		
+		// bytes must be the size the block was allocated with
+		void deallocate(void *p, size_t bytes)
+		{
+			if(bytes > NODE_POOL_MAX_BLOCK)
+			{
+				::operator delete(p);
+				return;
+			}
+			
+			FreeBlock *block = (FreeBlock *) p;
+			const size_t c = sizeClass(bytes);
+			lock_guard<mutex> guard(lock);
+			
+			block->next = free_lists[c];
+			free_lists[c] = block;
+		}
+		
+		// Bytes taken from the system for the pooled blocks
+		size_t bytesReserved()
+		{
+			lock_guard<mutex> guard(lock);
+			
+			return chunks.size() * chunk_size;
+		}
+		
+		size_t chunkSize() const
+		{
+			return chunk_size;
+		}
+};
+
+// Allocator for the standard containers, taking the memory from a NodePool, or from the heap if there is none
+template <class V>
+class PoolAllocator
+{
+	private:
+		template <class U>
+		friend class PoolAllocator;
+		
+		NodePool *pool;
+		
+	public:
+		typedef V value_type;
+		
+		template <class U>
+		struct rebind
+		{
+			typedef PoolAllocator<U> other;
+		};
+		
+		PoolAllocator(NodePool *pool = NULL) : pool(pool)
+		{
+		}
+		
+		template <class U>
+		PoolAllocator(const PoolAllocator<U> &a) : pool(a.pool)
+		{
+		}
+		
+		NodePool *getPool() const
+		{
+			return pool;
+		}
+		
+		V *allocate(size_t n)
+		{
+			return (V *) (pool == NULL? ::operator new(n * sizeof(V)): pool->allocate(n * sizeof(V)));
+		}
+		
+		void deallocate(V *p, size_t n)
+		{
+			if(pool == NULL)
+			{
+				::operator delete(p);
+			}
+			else
+			{
+				pool->deallocate(p, n * sizeof(V));
+			}
+		}
+		
+		template <class U>
+		bool operator==(const PoolAllocator<U> &a) const
+		{
+			return pool == a.pool;
+		}
+		
+		template <class U>
+		bool operator!=(const PoolAllocator<U> &a) const
+		{
+			return pool != a.pool;
+		}
+};
+
+#endif
@@ -0,0 +1,161 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _PARALLEL_H
+#define _PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Amount of work below which spawning a thread costs more than it saves
+#define PARALLEL_GRAIN 16384
+
+// Grain no amount of work reaches, so that parallelFor runs everything on the calling thread
+#define SERIAL_GRAIN ((size_t) -1)
+
+inline unsigned int numWorkers(size_t work, size_t grain = PARALLEL_GRAIN)
+{
+	unsigned int hw = thread::hardware_concurrency();
+	size_t by_work = work / grain + 1;
+
+	if(hw == 0)
+	{
+		hw = 1;
+	}
+
+	return (unsigned int) min((size_t) hw, by_work);
+}
+
+// Calls fn(lo, hi, worker) on disjoint contiguous chunks of [begin, end), one chunk per worker thread.
+// grain is the amount of items worth a thread of its own
+template <class Function>
+void parallelFor(size_t begin, size_t end, Function fn, size_t grain = PARALLEL_GRAIN)
+{
+	if(begin >= end)
+	{
+		return;
+	}
+
+	const unsigned int workers = numWorkers(end - begin, grain);
+
+	if(workers <= 1)
+	{
+		fn(begin, end, 0);
+		return;
+	}
+
+	const size_t chunk = (end - begin + workers - 1) / workers;
+	vector<thread> pool;
+
+	for(unsigned int w = 0; w < workers; w++)
+	{
+		size_t lo = begin + w * chunk;
+		size_t hi = min(end, lo + chunk);
+
+		if(lo >= hi)
+		{
+			break;
+		}
+
+		pool.push_back(thread(fn, lo, hi, w));
+	}
+
+	for(unsigned int w = 0; w < pool.size(); w++)
+	{
+		pool[w].join();
+	}
+}
+
+// Sorts the chunks concurrently and then merges neighbouring runs pairwise, also concurrently
+template <class RandomIt, class Compare>
+void parallelSort(RandomIt first, RandomIt last, Compare comp)
+{
+	const size_t n = last - first;
+	const unsigned int workers = numWorkers(n);
+
+	if(workers <= 1)
+	{
+		sort(first, last, comp);
+		return;
+	}
+
+	vector<size_t> bounds;
+	const size_t chunk = (n + workers - 1) / workers;
+
+	for(size_t lo = 0; lo < n; lo += chunk)
+	{
+		bounds.push_back(lo);
+	}
+
+	bounds.push_back(n);
+
+	// Every chunk is worth a thread of its own
+	parallelFor(0, bounds.size() - 1, [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t i = lo; i < hi; i++)
+		{
+			sort(first + bounds[i], first + bounds[i + 1], comp);
+		}
+	}, 1);
+
+	while(bounds.size() > 2)
+	{
+		vector<size_t> merged;
+		vector<thread> pool;
+
+		for(size_t i = 0; i + 2 < bounds.size(); i += 2)
+		{
+			RandomIt a = first + bounds[i], b = first + bounds[i + 1], c = first + bounds[i + 2];
+
+			pool.push_back(thread([a, b, c, comp]()
+			{
+				inplace_merge(a, b, c, comp);
+			}));
+
+			merged.push_back(bounds[i]);
+		}
+
+		// An odd run out is carried over to the next round as it is
+		if(bounds.size() % 2 == 0)
+		{
+			merged.push_back(bounds[bounds.size() - 2]);
+		}
+
+		merged.push_back(n);
+
+		for(unsigned int w = 0; w < pool.size(); w++)
+		{
+			pool[w].join();
+		}
+
+		bounds.swap(merged);
+	}
+}
+
+template <class RandomIt>
+void parallelSort(RandomIt first, RandomIt last)
+{
+	parallelSort(first, last, less<typename iterator_traits<RandomIt>::value_type>());
+}
+
+#endif
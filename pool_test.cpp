@@ -0,0 +1,226 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "graph.h"
+
+using namespace std;
+
+// Makes a vertex larger than the largest block of a pool
+struct LargeLabel
+{
+	int id;
+	char padding[NODE_POOL_MAX_BLOCK];
+	
+	LargeLabel(int id = 0) : id(id)
+	{
+	}
+	
+	bool operator<(const LargeLabel &l) const
+	{
+		return id < l.id;
+	}
+	
+	bool operator==(const LargeLabel &l) const
+	{
+		return id == l.id;
+	}
+};
+
+void addRandomGraph(Graph<int> &g, int n, int m)
+{
+	for(int i = 0; i < n; i++)
+	{
+		g.addVertex(i);
+	}
+	
+	for(int i = 0; i < m; i++)
+	{
+		g.addEdge(rand() % n, rand() % n, rand() % 5);
+	}
+}
+
+int main()
+{
+	shared_ptr<NodePool> pool(new NodePool());
+	Graph<char> g(true, pool);
+	
+	for(char c = 'A'; c <= 'E'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('A', 'B', 2);
+	g.addEdge('B', 'C', 3);
+	g.addEdge('C', 'A', 1);
+	g.addEdge('C', 'D', 4);
+	g.addEdge('D', 'E', 5);
+	g.removeVertex('B');
+	
+	cout << "Pooled graph:" << endl << g << endl;
+	cout << "Reversed:" << endl << g.reverse() << endl;
+	
+	// Graphs built one after another on the same pool reuse the blocks freed by the previous ones
+	size_t reserved_first = 0;
+	
+	for(int round = 0; round < 100; round++)
+	{
+		Graph<int> temp(false, pool);
+		
+		srand(5);
+		addRandomGraph(temp, 200, 600);
+		
+		if(round == 0)
+		{
+			reserved_first = pool->bytesReserved();
+		}
+	}
+	
+	cout << "Memory reserved by the shared pool grew after the first graph: " << (pool->bytesReserved() > reserved_first? "yes": "no") << endl;
+	
+	// Each of these owns its pool, which is released at once with the graph
+	unsigned int total_edges = 0;
+	
+	for(int round = 0; round < 100; round++)
+	{
+		Graph<int> temp(true, shared_ptr<NodePool>(new NodePool()));
+		
+		addRandomGraph(temp, 200, 600);
+		total_edges += temp.numEdges();
+	}
+	
+	cout << "Edges in the discarded graphs: " << total_edges << endl;
+	
+	// Vertices too large for the pool are freed one by one all the same
+	{
+		Graph<LargeLabel> large(false, shared_ptr<NodePool>(new NodePool()));
+		
+		for(int i = 0; i < 100; i++)
+		{
+			large.addVertex(LargeLabel(i));
+			large.addEdge(LargeLabel(i), LargeLabel(i / 2));
+		}
+		
+		cout << "Vertices with large labels: " << large.numVertices() << ", edges: " << large.numEdges() << endl;
+	}
+	
+	// Copies of a pooled graph modified on threads of their own. The forks share the pool, the deep copies get pools of their own
+	{
+		const int n = 300, num_threads = 4;
+		shared_ptr<NodePool> shared_pool(new NodePool());
+		Graph<int> pooled(true, shared_pool), reference(true);
+		
+		srand(29);
+		
+		for(int i = 0; i < n; i++)
+		{
+			pooled.addVertex(i);
+			reference.addVertex(i);
+		}
+		
+		for(int i = 0; i < 3 * n; i++)
+		{
+			int u = rand() % n, v = rand() % n, cost = rand() % 5;
+			
+			pooled.addEdge(u, v, cost);
+			reference.addEdge(u, v, cost);
+		}
+		
+		vector<Graph<int> > copies, references(num_threads, reference);
+		vector<thread> workers;
+		unsigned int mismatches = 0;
+		
+		copies.reserve(num_threads);
+		
+		for(int t = 0; t < num_threads; t++)
+		{
+			if(t % 2 == 0)
+			{
+				pooled.enableCopyOnWrite();
+			}
+			else
+			{
+				pooled.disableCopyOnWrite();
+			}
+			
+			copies.push_back(pooled);
+		}
+		
+		cout << "Graphs using the shared pool: " << shared_pool.use_count() - 1 << " of " << num_threads + 1 << endl;
+		
+		pooled = Graph<int>(true);
+		
+		for(int t = 0; t < num_threads; t++)
+		{
+			workers.push_back(thread([&copies, &references, t]()
+			{
+				Xoshiro256 rng(t + 1);
+				
+				for(int round = 0; round < 2000; round++)
+				{
+					int u = rng.below(n), v = rng.below(n), cost = rng.below(5), op = rng.below(10);
+					
+					for(int k = 0; k < 2; k++)
+					{
+						Graph<int> &g = k? references[t]: copies[t];
+						
+						if(op < 6)
+						{
+							g.addEdge(u, v, cost);
+						}
+						else if(op < 8)
+						{
+							g.removeEdge(u, v, cost);
+						}
+						else if(op == 8)
+						{
+							g.removeVertex(u);
+							g.addVertex(u);
+						}
+						else
+						{
+							g.simplify();
+						}
+					}
+				}
+			}));
+		}
+		
+		for(int t = 0; t < num_threads; t++)
+		{
+			ostringstream copy_out, reference_out;
+			
+			workers[t].join();
+			copy_out << copies[t];
+			reference_out << references[t];
+			mismatches += (copy_out.str() != reference_out.str());
+		}
+		
+		cout << "Copies modified concurrently, mismatches against graphs on the heap: " << mismatches << endl;
+	}
+	
+	return 0;
+}
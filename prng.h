@@ -0,0 +1,77 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _PRNG_H
+#define _PRNG_H
+
+#include <stdint.h>
+
+class Xoshiro256  // xoshiro256** generator, cheap enough to keep one per thread or per trial
+{
+	private:
+		uint64_t state[4];
+
+		static uint64_t rotl(uint64_t x, int k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+
+	public:
+		Xoshiro256(uint64_t seed)
+		{
+			// The state is expanded from the seed with splitmix64, so that nearby seeds give unrelated streams
+			for(int i = 0; i < 4; i++)
+			{
+				uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+				state[i] = z ^ (z >> 31);
+			}
+		}
+
+		uint64_t next()
+		{
+			const uint64_t res = rotl(state[1] * 5, 7) * 9;
+			const uint64_t t = state[1] << 17;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = rotl(state[3], 45);
+
+			return res;
+		}
+
+		// Uniform in [0, bound), the modulo bias is negligible for bounds far below 2^64
+		uint64_t below(uint64_t bound)
+		{
+			return next() % bound;
+		}
+
+		// Uniform in [0, 1)
+		double uniform()
+		{
+			return (next() >> 11) * (1.0 / 9007199254740992.0);
+		}
+};
+
+#endif
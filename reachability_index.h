@@ -0,0 +1,248 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _REACHABILITY_INDEX_H
+#define _REACHABILITY_INDEX_H
+
+#include <algorithm>
+#include <vector>
+
+#include "prng.h"
+#include "stamped_marks.h"
+
+using namespace std;
+
+/**
+	Reachability between the vertices 0 .. n-1 of a directed graph, from interval labels (GRAIL) over its condensation.
+
+	The condensation nodes are numbered so that every edge goes from a larger node to a smaller one, which is
+	what Tarjan's algorithm gives the strongly connected components. Each of the k randomized depth first
+	traversals labels a node with [smallest post order number below it, its own post order number]. A node
+	reaching another contains the other's interval in every traversal, so a missing containment or a smaller
+	source node answers no in O(k). Otherwise a depth first search settles it, pruned by the same two tests.
+	The index takes O(V + E) plus 2k numbers per node, and the queries only read it.
+**/
+class ReachabilityIndex
+{
+	private:
+		vector<unsigned int> component;	// Vertex -> node
+		vector<unsigned int> first;	// Successors of node x are succ[first[x]] .. succ[first[x+1]-1]
+		vector<unsigned int> succ;
+		vector<unsigned int> low, post;	// Interval of node x in traversal i is at x * k + i
+		unsigned int k;
+		
+		bool mayReach(unsigned int x, unsigned int y) const
+		{
+			if(x < y)
+			{
+				return false;
+			}
+			
+			for(unsigned int i = 0; i < k; i++)
+			{
+				if(low[y * k + i] < low[x * k + i] || post[y * k + i] > post[x * k + i])
+				{
+					return false;
+				}
+			}
+			
+			return true;
+		}
+		
+		// Marks of the query searches, reused from one query to the next so a query only pays for the nodes it touches.
+		// They are kept per thread, so that the queries still only read the index and can run together
+		static StampedMarks & queryMarks(unsigned int num_nodes)
+		{
+			static thread_local StampedMarks marks;
+			
+			if(marks.size() < num_nodes)
+			{
+				marks.resize(num_nodes);
+			}
+			
+			return marks;
+		}
+		
+		// Post order numbering from a traversal which visits the roots and the successors starting at random offsets
+		void label(unsigned int traversal, Xoshiro256 &rng)
+		{
+			const unsigned int num_nodes = first.size() - 1;
+			vector<bool> visited(num_nodes, false);
+			vector<pair<unsigned int, unsigned int> > st;	// Node and the number of successors seen
+			vector<unsigned int> offset(num_nodes);
+			unsigned int counter = 0;
+			
+			for(unsigned int x = 0; x < num_nodes; x++)
+			{
+				unsigned int degree = first[x + 1] - first[x];
+				
+				offset[x] = (degree > 1)? rng.below(degree): 0;
+			}
+			
+			unsigned int start = rng.below(num_nodes);
+			
+			for(unsigned int r = 0; r < num_nodes; r++)
+			{
+				unsigned int root = (start + r) % num_nodes;
+				
+				if(visited[root])
+				{
+					continue;
+				}
+				
+				visited[root] = true;
+				low[root * k + traversal] = num_nodes;
+				st.push_back(make_pair(root, 0));
+				
+				while(!st.empty())
+				{
+					unsigned int x = st.back().first;
+					unsigned int degree = first[x + 1] - first[x];
+					
+					if(st.back().second == degree)
+					{
+						post[x * k + traversal] = counter;
+						low[x * k + traversal] = min(low[x * k + traversal], counter);
+						counter++;
+						st.pop_back();
+						
+						if(!st.empty())
+						{
+							unsigned int parent = st.back().first;
+							
+							low[parent * k + traversal] = min(low[parent * k + traversal], low[x * k + traversal]);
+						}
+						
+						continue;
+					}
+					
+					unsigned int y = succ[first[x] + (offset[x] + st.back().second++) % degree];
+					
+					if(visited[y])
+					{
+						// Already finished, since the condensation has no cycle
+						low[x * k + traversal] = min(low[x * k + traversal], low[y * k + traversal]);
+					}
+					else
+					{
+						visited[y] = true;
+						low[y * k + traversal] = num_nodes;
+						st.push_back(make_pair(y, 0));
+					}
+				}
+			}
+		}
+		
+	public:
+		ReachabilityIndex() : k(0)
+		{
+		}
+		
+		// edges are pairs of nodes, each going from a larger node to a smaller one. Repeated pairs and loops are allowed
+		void build(const vector<unsigned int> &component, unsigned int num_nodes, vector<pair<unsigned int, unsigned int> > &edges, unsigned int num_intervals)
+		{
+			Xoshiro256 rng(num_nodes);
+			
+			this->component = component;
+			k = num_intervals;
+			
+			sort(edges.begin(), edges.end());
+			edges.erase(unique(edges.begin(), edges.end()), edges.end());
+			
+			first.assign(num_nodes + 1, 0);
+			succ.clear();
+			succ.reserve(edges.size());
+			
+			for(unsigned int i = 0; i < edges.size(); i++)
+			{
+				if(edges[i].first != edges[i].second)
+				{
+					first[edges[i].first + 1]++;
+					succ.push_back(edges[i].second);
+				}
+			}
+			
+			for(unsigned int x = 0; x < num_nodes; x++)
+			{
+				first[x + 1] += first[x];
+			}
+			
+			low.assign(num_nodes * k, 0);
+			post.assign(num_nodes * k, 0);
+			
+			for(unsigned int i = 0; i < k && num_nodes > 0; i++)
+			{
+				label(i, rng);
+			}
+		}
+		
+		bool reachable(unsigned int u, unsigned int v) const
+		{
+			const unsigned int target = component[v];
+			unsigned int source = component[u];
+			
+			if(source == target)
+			{
+				return true;
+			}
+			
+			if(!mayReach(source, target))
+			{
+				return false;
+			}
+			
+			// Depth first search, only into the nodes which may still reach the target
+			vector<unsigned int> st(1, source);
+			StampedMarks &seen = queryMarks(first.size() - 1);
+			const unsigned int mark = seen.next();
+			
+			seen.mark(source, mark);
+			
+			while(!st.empty())
+			{
+				unsigned int x = st.back();
+				st.pop_back();
+				
+				for(unsigned int i = first[x]; i < first[x + 1]; i++)
+				{
+					unsigned int y = succ[i];
+					
+					if(y == target)
+					{
+						return true;
+					}
+					
+					if(!seen.marked(y, mark) && mayReach(y, target))
+					{
+						seen.mark(y, mark);
+						st.push_back(y);
+					}
+				}
+			}
+			
+			return false;
+		}
+		
+		unsigned int numElements() const
+		{
+			return component.size();
+		}
+};
+
+#endif
@@ -0,0 +1,104 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+int main()
+{
+	Graph<char> g(true);
+	
+	for(char c = 'a'; c <= 'h'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	// b, c and d form a cycle
+	g.addEdge('a', 'b');
+	g.addEdge('b', 'c');
+	g.addEdge('c', 'd');
+	g.addEdge('d', 'b');
+	g.addEdge('d', 'e');
+	g.addEdge('f', 'e');
+	g.addEdge('g', 'h');
+	
+	g.enableReachabilityIndex();
+	
+	cout << "a -> e: " << g.pathExists('a', 'e') << endl;
+	cout << "d -> c: " << g.pathExists('d', 'c') << endl;
+	cout << "e -> a: " << g.pathExists('e', 'a') << endl;
+	cout << "f -> b: " << g.pathExists('f', 'b') << endl;
+	cout << "a -> h: " << g.pathExists('a', 'h') << endl;
+	
+	g.addEdge('e', 'g');
+	
+	cout << "a -> h after adding e -> g: " << g.pathExists('a', 'h') << endl;
+	
+	// Random graphs, with modifications between the queries, must agree with the plain search
+	Graph<int> indexed(true), plain(true);
+	const int n = 400;
+	unsigned int mismatches = 0, positives = 0;
+	
+	indexed.enableReachabilityIndex();
+	srand(11);
+	
+	for(int i = 0; i < n; i++)
+	{
+		indexed.addVertex(i);
+		plain.addVertex(i);
+	}
+	
+	for(int round = 0; round < 20; round++)
+	{
+		for(int i = 0; i < n / 4; i++)
+		{
+			int u = rand() % n, v = rand() % n;
+			
+			// Mostly forward edges, so that the graph stays close to a DAG
+			if(rand() % 10 != 0 && u > v)
+			{
+				swap(u, v);
+			}
+			
+			indexed.addEdge(u, v);
+			plain.addEdge(u, v);
+		}
+		
+		for(int i = 0; i < 200; i++)
+		{
+			int u = rand() % n, v = rand() % n;
+			bool expected = plain.pathExists(u, v);
+			
+			positives += expected;
+			
+			if(indexed.pathExists(u, v) != expected)
+			{
+				mismatches++;
+			}
+		}
+	}
+	
+	cout << "Random queries: " << positives << " reachable, " << mismatches << " mismatch(es)" << endl;
+	
+	return 0;
+}
@@ -0,0 +1,285 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _SPARSE_MATRIX_H
+#define _SPARSE_MATRIX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "parallel.h"
+
+using namespace std;
+
+/**
+	Sparse matrix in compressed sparse row form. The entries of row r are first[r] .. first[r+1]-1
+	of col and value, in increasing order of the columns. Repeated entries are allowed, they are
+	combined by the additive operation of the semiring in spmv().
+**/
+template <class V>
+class SparseMatrix
+{
+	private:
+		unsigned int num_rows, num_cols;
+		vector<size_t> first;
+		vector<unsigned int> col;
+		vector<V> value;
+		
+	public:
+		SparseMatrix() : num_rows(0), num_cols(0), first(1, 0)
+		{
+		}
+		
+		// Builds from coordinate triples in any order, by a counting sort on the columns and then a stable one on the rows
+		SparseMatrix(unsigned int num_rows, unsigned int num_cols, const vector<unsigned int> &rows, const vector<unsigned int> &cols, const vector<V> &values)
+			: num_rows(num_rows), num_cols(num_cols), first(num_rows + 1, 0), col(rows.size()), value(rows.size())
+		{
+			vector<size_t> by_col(num_cols + 1, 0), order(rows.size());
+			
+			for(size_t e = 0; e < cols.size(); e++)
+			{
+				by_col[cols[e] + 1]++;
+				first[rows[e] + 1]++;
+			}
+			
+			for(unsigned int c = 0; c < num_cols; c++)
+			{
+				by_col[c + 1] += by_col[c];
+			}
+			
+			for(unsigned int r = 0; r < num_rows; r++)
+			{
+				first[r + 1] += first[r];
+			}
+			
+			for(size_t e = 0; e < cols.size(); e++)
+			{
+				order[by_col[cols[e]]++] = e;
+			}
+			
+			vector<size_t> pos(first.begin(), first.end() - 1);
+			
+			for(size_t i = 0; i < order.size(); i++)
+			{
+				size_t e = order[i], p = pos[rows[e]]++;
+				
+				col[p] = cols[e];
+				value[p] = values[e];
+			}
+		}
+		
+		// Row indices of the entries, which along with colIndices() and values() is the coordinate form
+		vector<unsigned int> rowIndices() const
+		{
+			vector<unsigned int> rows(col.size());
+			
+			for(unsigned int r = 0; r < num_rows; r++)
+			{
+				fill(rows.begin() + first[r], rows.begin() + first[r + 1], r);
+			}
+			
+			return rows;
+		}
+		
+		// Counting sort on the columns, which keeps the rows of the transpose in increasing order as well
+		SparseMatrix<V> transposed() const
+		{
+			SparseMatrix<V> t;
+			
+			t.num_rows = num_cols;
+			t.num_cols = num_rows;
+			t.first.assign(num_cols + 1, 0);
+			t.col.resize(col.size());
+			t.value.resize(value.size());
+			
+			for(size_t e = 0; e < col.size(); e++)
+			{
+				t.first[col[e] + 1]++;
+			}
+			
+			for(unsigned int c = 0; c < num_cols; c++)
+			{
+				t.first[c + 1] += t.first[c];
+			}
+			
+			vector<size_t> pos(t.first.begin(), t.first.end() - 1);
+			
+			for(unsigned int r = 0; r < num_rows; r++)
+			{
+				for(size_t e = first[r]; e < first[r + 1]; e++)
+				{
+					size_t p = pos[col[e]]++;
+					
+					t.col[p] = r;
+					t.value[p] = value[e];
+				}
+			}
+			
+			return t;
+		}
+		
+		unsigned int numRows() const
+		{
+			return num_rows;
+		}
+		
+		unsigned int numCols() const
+		{
+			return num_cols;
+		}
+		
+		size_t numEntries() const
+		{
+			return col.size();
+		}
+		
+		const vector<size_t> & rowStarts() const
+		{
+			return first;
+		}
+		
+		const vector<unsigned int> & colIndices() const
+		{
+			return col;
+		}
+		
+		const vector<V> & values() const
+		{
+			return value;
+		}
+};
+
+// Semirings for spmv(), each with the identity of its addition and the two operations.
+// multiply() combines an entry of the matrix with an element of the vector
+
+// Ordinary arithmetic, for PageRank and path counting
+template <class X>
+struct PlusTimes
+{
+	typedef X value_type;
+	
+	static X zero()
+	{
+		return X();
+	}
+	
+	static X add(X a, X b)
+	{
+		return a + b;
+	}
+	
+	template <class V>
+	static X multiply(V entry, X x)
+	{
+		return (X) entry * x;
+	}
+};
+
+// Tropical semiring for shortest path relaxations, the largest value stands for infinity
+template <class X>
+struct MinPlus
+{
+	typedef X value_type;
+	
+	static X zero()
+	{
+		return numeric_limits<X>::max();
+	}
+	
+	static X add(X a, X b)
+	{
+		return min(a, b);
+	}
+	
+	template <class V>
+	static X multiply(V entry, X x)
+	{
+		return (x == zero())? x: (X) entry + x;
+	}
+};
+
+// Boolean semiring for reachability and breadth first frontiers, the entries count by their presence alone
+struct OrAnd
+{
+	typedef unsigned char value_type;	// vector<bool> can not be written by several threads
+	
+	static unsigned char zero()
+	{
+		return 0;
+	}
+	
+	static unsigned char add(unsigned char a, unsigned char b)
+	{
+		return a | b;
+	}
+	
+	template <class V>
+	static unsigned char multiply(V, unsigned char x)
+	{
+		return x;
+	}
+};
+
+// y[r] = sum over the entries (r, c) of multiply(entry, x[c]), in the semiring S. The rows are split among the threads
+// by the number of entries. Use the transpose for the pull along the incoming edges, as in PageRank and Bellman-Ford
+template <class S, class V>
+void spmv(const SparseMatrix<V> &a, const vector<typename S::value_type> &x, vector<typename S::value_type> &y, bool parallel = true)
+{
+	typedef typename S::value_type X;
+	
+	const vector<size_t> &first = a.rowStarts();
+	const vector<unsigned int> &col = a.colIndices();
+	const vector<V> &value = a.values();
+	
+	y.assign(a.numRows(), S::zero());
+	
+	const unsigned int workers = parallel? numWorkers(a.numEntries() + a.numRows()): 1;
+	
+	// Row boundaries, so that every chunk has about the same number of entries
+	vector<unsigned int> bounds(workers + 1, a.numRows());
+	
+	bounds[0] = 0;
+	
+	for(unsigned int w = 1; w < workers; w++)
+	{
+		bounds[w] = upper_bound(first.begin(), first.end(), a.numEntries() * w / workers) - first.begin() - 1;
+	}
+	
+	parallelFor(0, workers, [&](size_t lo, size_t hi, unsigned int)
+	{
+		for(size_t w = lo; w < hi; w++)
+		{
+			for(unsigned int r = bounds[w]; r < bounds[w + 1]; r++)
+			{
+				X acc = S::zero();
+				
+				for(size_t e = first[r]; e < first[r + 1]; e++)
+				{
+					acc = S::add(acc, S::multiply(value[e], x[col[e]]));
+				}
+				
+				y[r] = acc;
+			}
+		}
+	}, 1);
+}
+
+#endif
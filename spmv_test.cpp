@@ -0,0 +1,189 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+int main()
+{
+	Graph<char> g(true);
+	
+	for(char c = 'a'; c <= 'd'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('a', 'b', 3);
+	g.addEdge('a', 'c', 1);
+	g.addEdge('b', 'c', 2);
+	g.addEdge('c', 'a', 5);
+	g.addEdge('d', 'c', 4);
+	
+	pair<vector<char>, SparseMatrix<int> > m = g.sparseMatrix();
+	vector<unsigned int> rows = m.second.rowIndices();
+	
+	cout << "Coordinate form:";
+	for(unsigned int e = 0; e < m.second.numEntries(); e++)
+	{
+		cout << " (" << m.first[rows[e]] << ", " << m.first[m.second.colIndices()[e]] << ") = " << m.second.values()[e];
+	}
+	cout << endl;
+	
+	// PageRank, pulling along the incoming edges with the out degrees folded into the entries. Nothing links to d,
+	// so it is left with the share of the random jumps alone
+	const unsigned int n = m.first.size();
+	vector<unsigned int> out(n, 0);
+	
+	for(unsigned int e = 0; e < rows.size(); e++)
+	{
+		out[rows[e]]++;
+	}
+	
+	vector<double> weights(rows.size());
+	
+	for(unsigned int e = 0; e < rows.size(); e++)
+	{
+		weights[e] = 1.0 / out[rows[e]];
+	}
+	
+	SparseMatrix<double> pull = SparseMatrix<double>(n, n, rows, m.second.colIndices(), weights).transposed();
+	vector<double> rank(n, 1.0 / n), next;
+	
+	for(int iter = 0; iter < 50; iter++)
+	{
+		spmv<PlusTimes<double> >(pull, rank, next);
+		
+		for(unsigned int i = 0; i < n; i++)
+		{
+			rank[i] = 0.15 / n + 0.85 * next[i];
+		}
+	}
+	
+	cout.precision(3);
+	cout << "PageRank:";
+	for(unsigned int i = 0; i < n; i++)
+	{
+		cout << " " << m.first[i] << "=" << rank[i];
+	}
+	cout << endl;
+	
+	// Random graphs: breadth first levels in the boolean semiring and Bellman-Ford in the tropical one,
+	// against the searches of the graph
+	Graph<int> r(true);
+	const int size = 500;
+	unsigned int mismatches = 0, reached = 0;
+	
+	srand(9);
+	
+	for(int i = 0; i < size; i++)
+	{
+		r.addVertex(i);
+	}
+	
+	for(int i = 0; i < 3 * size; i++)
+	{
+		r.addEdge(rand() % size, rand() % size, rand() % 50);
+	}
+	
+	pair<vector<int>, SparseMatrix<int> > rm = r.sparseMatrix();
+	SparseMatrix<int> incoming = rm.second.transposed();
+	
+	for(int source = 0; source < size; source += 50)
+	{
+		vector<unsigned char> frontier(size, 0), seen(size, 0), reach;
+		vector<int> level(size, -1);
+		
+		frontier[source] = seen[source] = 1;
+		level[source] = 0;
+		
+		for(int depth = 1; ; depth++)
+		{
+			bool grown = false;
+			
+			spmv<OrAnd>(incoming, frontier, reach);
+			
+			for(int i = 0; i < size; i++)
+			{
+				frontier[i] = reach[i] && !seen[i];
+				
+				if(frontier[i])
+				{
+					seen[i] = 1;
+					level[i] = depth;
+					grown = true;
+				}
+			}
+			
+			if(!grown)
+			{
+				break;
+			}
+		}
+		
+		vector<int> dist(size, MinPlus<int>::zero()), relaxed;
+		
+		dist[source] = 0;
+		
+		for(int iter = 0; iter < size - 1; iter++)
+		{
+			bool changed = false;
+			
+			spmv<MinPlus<int> >(incoming, dist, relaxed);
+			
+			for(int i = 0; i < size; i++)
+			{
+				if(relaxed[i] < dist[i])
+				{
+					dist[i] = relaxed[i];
+					changed = true;
+				}
+			}
+			
+			if(!changed)
+			{
+				break;
+			}
+		}
+		
+		map<int, pair<int, int> > expected = r.bellmanFordShortestPath(source);
+		
+		for(int i = 0; i < size; i++)
+		{
+			reached += (level[i] != -1);
+			
+			if(level[i] != r.hop_distance(source, i))
+			{
+				mismatches++;
+			}
+			
+			if((level[i] == -1)? expected[i].second != (int) INFINITY: expected[i].second != dist[i])
+			{
+				mismatches++;
+			}
+		}
+	}
+	
+	cout << "Random sources: " << reached << " reached, " << mismatches << " mismatch(es)" << endl;
+	
+	return 0;
+}
@@ -0,0 +1,89 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#ifndef _STAMPED_MARKS_H
+#define _STAMPED_MARKS_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+	Visited marks over the elements 0 .. n-1 for searches which run one after another.
+
+	Each search takes a new stamp and marks the elements it reaches with it, so starting a search is O(1) instead of
+	clearing a mark per element. Stamps are never reused until they wrap around, only then are the marks cleared.
+**/
+class StampedMarks
+{
+	private:
+		vector<unsigned int> marks;
+		unsigned int stamp;
+		
+	public:
+		StampedMarks(unsigned int n = 0) : marks(n, 0), stamp(0)
+		{
+		}
+		
+		void reset(unsigned int n)
+		{
+			marks.assign(n, 0);
+			stamp = 0;
+		}
+		
+		// The elements added are unmarked
+		void resize(unsigned int n)
+		{
+			marks.resize(n, 0);
+		}
+		
+		unsigned int size() const
+		{
+			return marks.size();
+		}
+		
+		unsigned int next()
+		{
+			if(stamp >= 0xFFFFFFF0u)
+			{
+				marks.assign(marks.size(), 0);
+				stamp = 0;
+			}
+			
+			return ++stamp;
+		}
+		
+		bool marked(unsigned int elem, unsigned int st) const
+		{
+			return marks[elem] == st;
+		}
+		
+		void mark(unsigned int elem, unsigned int st)
+		{
+			marks[elem] = st;
+		}
+		
+		// Element to takes over the mark of from
+		void move(unsigned int from, unsigned int to)
+		{
+			marks[to] = marks[from];
+		}
+};
+
+#endif
@@ -0,0 +1,141 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+#include <cstdlib>
+#include <iostream>
+
+#include "graph.h"
+
+using namespace std;
+
+void printOrder(const vector<int> &order)
+{
+	for(int i = 0; i < order.size(); i++)
+	{
+		cout << order[i] << " ";
+	}
+	
+	cout << endl;
+}
+
+// Every edge has to go forward in the order
+bool isTopological(const Graph<int> &g, const vector<int> &order)
+{
+	map<int, int> position;
+	
+	for(int i = 0; i < order.size(); i++)
+	{
+		position[order[i]] = i;
+	}
+	
+	vector<Edge<int> *> edges = g.getEdges();
+	bool res = (order.size() == g.numVertices());
+	
+	for(int i = 0; i < edges.size(); i++)
+	{
+		if(position[edges[i]->src] >= position[edges[i]->dest])
+		{
+			res = false;
+		}
+		
+		delete edges[i];
+	}
+	
+	return res;
+}
+
+int main()
+{
+	Graph<int> g(true);
+	
+	for(int i = 1; i <= 6; i++)
+	{
+		g.addVertex(i);
+	}
+	
+	g.enableTopologicalOrder();
+	
+	g.addEdge(1, 2);
+	g.addEdge(2, 3);
+	g.addEdge(4, 5);
+	
+	cout << "Order: ";
+	printOrder(g.topologicalOrder());
+	
+	cout << "Adding 5 -> 1: " << g.addEdge(5, 1) << endl;
+	cout << "Order: ";
+	printOrder(g.topologicalOrder());
+	
+	cout << "Adding 3 -> 4: " << g.addEdge(3, 4) << endl;
+	cout << "Adding 6 -> 6: " << g.addEdge(6, 6) << endl;
+	
+	g.removeEdge(5, 1);
+	
+	cout << "Adding 3 -> 4 after removing 5 -> 1: " << g.addEdge(3, 4) << endl;
+	cout << "Order: ";
+	printOrder(g.topologicalOrder());
+	
+	// Random insertions, the ones refused must be exactly those which close a cycle
+	Graph<int> indexed(true);
+	const int n = 300;
+	unsigned int mismatches = 0;
+	
+	indexed.enableTopologicalOrder();
+	srand(5);
+	
+	for(int i = 0; i < n; i++)
+	{
+		indexed.addVertex(i);
+	}
+	
+	for(int i = 0; i < 6 * n; i++)
+	{
+		int u = rand() % n, v = rand() % n;
+		int op = rand() % 20;
+		
+		if(op == 0)
+		{
+			indexed.removeVertex(u);
+			indexed.addVertex(u);
+		}
+		else if(op < 4)
+		{
+			indexed.removeEdge(u, v);
+		}
+		else
+		{
+			bool closes_cycle = (u == v) || indexed.pathExists(v, u);
+			
+			if(indexed.addEdge(u, v) == closes_cycle)
+			{
+				mismatches++;
+			}
+		}
+		
+		if(i % 50 == 0 && !isTopological(indexed, indexed.topologicalOrder()))
+		{
+			mismatches++;
+		}
+	}
+	
+	cout << "Streaming: " << indexed.numEdges() << " edge(s), " << mismatches << " mismatch(es), ";
+	cout << "topological: " << isTopological(indexed, indexed.topologicalOrder()) << endl;
+	
+	return 0;
+}
@@ -72,5 +72,26 @@ int main()
 	
 	cout << "\b\b" << endl;
 	
+	vector<vector<int> > levels;
+	
+	g.topologicalLevels(levels);
+	
+	cout << "Levels: " << endl;
+	for(int i = 0; i < levels.size(); i++)
+	{
+		cout << i << ": ";
+		
+		for(int j = 0; j < levels[i].size(); j++)
+		{
+			cout << levels[i][j] << " ";
+		}
+		
+		cout << endl;
+	}
+	
+	g.addEdge(7, 2);
+	
+	cout << "With 7 -> 2, sorted: " << g.topologicalSort(ts) << ", levelled: " << g.topologicalLevels(levels) << endl;
+	
 	return 0;
 }
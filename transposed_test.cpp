@@ -0,0 +1,145 @@
+/**
+Implementation of Graph algorithms in one single class
+Copyright (C) Suresh P (sureshsonait@gmail.com)
+
+This program is free software; you can redistribute it and/or
+modify it under the terms of the GNU General Public License
+as published by the Free Software Foundation; either version 2
+of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+**/
+
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "graph.h"
+
+using namespace std;
+
+// Every copy of every edge, reversed if asked to, in a fixed order
+vector<tuple<int, int, int> > edgeList(const Graph<int> &g, bool reversed)
+{
+	vector<Edge<int> > edges;
+	vector<tuple<int, int, int> > res;
+	
+	g.exportEdges(edges);
+	
+	for(unsigned int i = 0; i < edges.size(); i++)
+	{
+		if(reversed || !g.isDirected())
+		{
+			res.push_back(make_tuple(edges[i].dest, edges[i].src, edges[i].cost));
+		}
+		
+		if(!reversed || !g.isDirected())
+		{
+			res.push_back(make_tuple(edges[i].src, edges[i].dest, edges[i].cost));
+		}
+	}
+	
+	sort(res.begin(), res.end());
+	
+	return res;
+}
+
+int main()
+{
+	Graph<char> g(true);
+	
+	for(char c = 'A'; c <= 'E'; c++)
+	{
+		g.addVertex(c);
+	}
+	
+	g.addEdge('A', 'B', 4);
+	g.addEdge('A', 'C', 1);
+	g.addEdge('C', 'B', 2);
+	g.addEdge('B', 'D', 5);
+	g.addEdge('C', 'D', 8);
+	g.addEdge('D', 'E', 3);
+	
+	TransposedView<char> view(g);
+	
+	cout << "Original:" << endl << g << endl;
+	cout << "Transposed:" << endl << *view << endl;
+	
+	// Shortest paths into E are the shortest paths out of E in the transposed graph
+	map<char, pair<char, int> > to_e = view->dijkstraShortestPath('E');
+	
+	for(map<char, pair<char, int> >::iterator itr = to_e.begin(); itr != to_e.end(); itr++)
+	{
+		cout << itr->first << " to E: " << itr->second.second << ", in-degree " << view->indegree(itr->first) << " = out-degree " << g.outdegree(itr->first) << endl;
+	}
+	
+	g.addEdge('E', 'A', 9);
+	g.removeEdge('A', 'C', 1);
+	cout << endl << "The view keeps the edges it was taken with: " << view->numEdges() << " edges, A -> C reversed: " << view->edgeExists('C', 'A') << endl << endl;
+	
+	for(int directed = 0; directed < 2; directed++)
+	{
+		const int n = 80;
+		Graph<int> r(directed);
+		
+		srand(7 + directed);
+		
+		for(int i = 0; i < n; i++)
+		{
+			r.addVertex(i);
+		}
+		
+		for(int i = 0; i < 2 * n; i++)
+		{
+			r.addEdge(rand() % n, rand() % n, rand() % 9);
+		}
+		
+		r.removeVertex(n / 2);
+		r.simplify();
+		
+		Graph<int> reversed = r.reverse();
+		unsigned int mismatches = (edgeList(reversed, false) != edgeList(r, true));
+		
+		reversed.addEdge(0, 1, 5);
+		mismatches += (edgeList(reversed, false) == edgeList(r, true));
+		
+		// Vertices are in the same strongly connected component if and only if each reaches the other
+		vector<vector<int> > components = r.getVerticesComponentwise();
+		map<int, unsigned int> component;
+		
+		for(unsigned int c = 0; c < components.size(); c++)
+		{
+			for(unsigned int i = 0; i < components[c].size(); i++)
+			{
+				component[components[c][i]] = c;
+			}
+		}
+		
+		vector<int> labels = r.getVertices();
+		
+		for(unsigned int i = 0; i < labels.size(); i++)
+		{
+			for(unsigned int j = 0; j < labels.size(); j += 7)
+			{
+				bool same = r.pathExists(labels[i], labels[j]) && r.pathExists(labels[j], labels[i]);
+				
+				mismatches += (same != (component[labels[i]] == component[labels[j]]));
+			}
+		}
+		
+		cout << (directed? "Directed": "Undirected") << ": " << components.size() << " components, " << mismatches << " mismatches" << endl;
+	}
+	
+	return 0;
+}